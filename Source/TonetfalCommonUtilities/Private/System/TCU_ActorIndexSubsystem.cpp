@@ -0,0 +1,445 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#include "System/TCU_ActorIndexSubsystem.h"
+
+#include "Algo/AllOf.h"
+#include "Algo/AnyOf.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "System/TCU_WorldResolver.h"
+
+UTCU_ActorIndexSubsystem* UTCU_ActorIndexSubsystem::Get(const UObject* ContextObject)
+{
+	const UWorld* World = FTCU_WorldResolver::Resolve(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	return IsValid(World) ? World->GetSubsystem<ThisClass>() : nullptr;
+}
+
+void UTCU_ActorIndexSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const UWorld* World = GetWorld();
+	check(IsValid(World));
+
+	ActorSpawnedHandle = World->AddOnActorSpawnedHandler(
+		FOnActorSpawned::FDelegate::CreateUObject(this, &ThisClass::OnActorSpawned));
+	ActorDestroyedHandle = World->AddOnActorDestroyedHandler(
+		FOnActorDestroyed::FDelegate::CreateUObject(this, &ThisClass::OnActorDestroyed));
+
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &ThisClass::OnLevelAddedToWorld);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &ThisClass::OnLevelRemovedFromWorld);
+}
+
+void UTCU_ActorIndexSubsystem::Deinitialize()
+{
+	if (const UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+		World->RemoveOnActorDestroyededHandler(ActorDestroyedHandle);
+	}
+
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+
+	InterfaceBuckets.Empty();
+	TagBuckets.Empty();
+
+	Super::Deinitialize();
+}
+
+AActor* UTCU_ActorIndexSubsystem::GetActorWithInterface(TSubclassOf<UInterface> Interface)
+{
+	if (!Interface)
+	{
+		return nullptr;
+	}
+
+	FActorBucket& Bucket = FindOrBuildInterfaceBucket(Interface);
+	return GetFirstValidActor(Bucket);
+}
+
+void UTCU_ActorIndexSubsystem::GetActorsWithInterface(TSubclassOf<UInterface> Interface, TArray<AActor*>& OutActors)
+{
+	if (!Interface)
+	{
+		return;
+	}
+
+	const FActorBucket& Bucket = FindOrBuildInterfaceBucket(Interface);
+	OutActors.Reserve(OutActors.Num() + Bucket.Actors.Num());
+
+	for (const TWeakObjectPtr<AActor>& Actor : Bucket.Actors)
+	{
+		if (AActor* ValidActor = Actor.Get(); IsValid(ValidActor))
+		{
+			OutActors.Add(ValidActor);
+		}
+	}
+}
+
+AActor* UTCU_ActorIndexSubsystem::GetActorWithTag(TSubclassOf<AActor> ActorClass, FName Tag)
+{
+	if (Tag.IsNone())
+	{
+		return nullptr;
+	}
+
+	FActorBucket& Bucket = FindOrBuildTagBucket(ActorClass, Tag);
+	return GetFirstValidTaggedActor(Bucket, Tag);
+}
+
+void UTCU_ActorIndexSubsystem::GetActorsWithTag(TSubclassOf<AActor> ActorClass, FName Tag,
+	TArray<AActor*>& OutActors)
+{
+	GetActorsWithAllTags(ActorClass, MakeArrayView(&Tag, 1), OutActors);
+}
+
+void UTCU_ActorIndexSubsystem::GetActorsWithAllTags(TSubclassOf<AActor> ActorClass, TConstArrayView<FName> Tags,
+	TArray<AActor*>& OutActors)
+{
+	if (Tags.IsEmpty())
+	{
+		return;
+	}
+
+	for (const FName Tag : Tags)
+	{
+		if (Tag.IsNone())
+		{
+			return;
+		}
+
+		FindOrBuildTagBucket(ActorClass, Tag);
+	}
+
+	// Walk the smallest bucket and check the rest of the tags on its actors. Buckets are looked up again once they
+	// all exist, since building one can reallocate the map
+	FActorBucket* SmallestBucket = nullptr;
+	FName SmallestBucketTag;
+	for (const FName Tag : Tags)
+	{
+		FActorBucket& Bucket = FindOrBuildTagBucket(ActorClass, Tag);
+		if (!SmallestBucket || Bucket.Actors.Num() < SmallestBucket->Actors.Num())
+		{
+			SmallestBucket = &Bucket;
+			SmallestBucketTag = Tag;
+		}
+	}
+
+	OutActors.Reserve(OutActors.Num() + SmallestBucket->Actors.Num());
+
+	SmallestBucket->Actors.RemoveAllSwap([&](const TWeakObjectPtr<AActor>& Actor)
+	{
+		AActor* ValidActor = Actor.Get();
+		if (!IsValid(ValidActor) || !ValidActor->ActorHasTag(SmallestBucketTag))
+		{
+			// The actor is gone, or the tag has been removed from it behind our back
+			return true;
+		}
+
+		const bool bHasAllTags = Algo::AllOf(Tags, [ValidActor](const FName Tag)
+		{
+			return ValidActor->ActorHasTag(Tag);
+		});
+
+		if (bHasAllTags)
+		{
+			OutActors.Add(ValidActor);
+		}
+
+		return false;
+	});
+}
+
+void UTCU_ActorIndexSubsystem::GetActorsWithAnyTag(TSubclassOf<AActor> ActorClass, TConstArrayView<FName> Tags,
+	TArray<AActor*>& OutActors)
+{
+	for (int32 TagIndex = 0; TagIndex < Tags.Num(); TagIndex++)
+	{
+		const FName Tag = Tags[TagIndex];
+		if (Tag.IsNone())
+		{
+			continue;
+		}
+
+		// Actors that have any of the previous tags have already been gathered from their buckets
+		const TConstArrayView<FName> PreviousTags = Tags.Left(TagIndex);
+
+		FActorBucket& Bucket = FindOrBuildTagBucket(ActorClass, Tag);
+		Bucket.Actors.RemoveAllSwap([&](const TWeakObjectPtr<AActor>& Actor)
+		{
+			AActor* ValidActor = Actor.Get();
+			if (!IsValid(ValidActor) || !ValidActor->ActorHasTag(Tag))
+			{
+				return true;
+			}
+
+			const bool bAlreadyGathered = Algo::AnyOf(PreviousTags, [ValidActor](const FName PreviousTag)
+			{
+				return ValidActor->ActorHasTag(PreviousTag);
+			});
+
+			if (!bAlreadyGathered)
+			{
+				OutActors.Add(ValidActor);
+			}
+
+			return false;
+		});
+	}
+}
+
+void UTCU_ActorIndexSubsystem::NotifyActorTagsChanged(AActor* Actor)
+{
+	if (!IsValid(Actor))
+	{
+		return;
+	}
+
+	for (auto& [Key, Bucket] : TagBuckets)
+	{
+		Bucket.Actors.RemoveSingleSwap(Actor);
+
+		if (MatchesTagKey(Actor, Key))
+		{
+			Bucket.Actors.Add(Actor);
+		}
+	}
+}
+
+bool UTCU_ActorIndexSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	// Editor worlds don't route spawn/destroy notifications reliably; library falls back to scanning for them
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+UTCU_ActorIndexSubsystem::FActorBucket& UTCU_ActorIndexSubsystem::FindOrBuildInterfaceBucket(UClass* Interface)
+{
+	if (FActorBucket* Bucket = InterfaceBuckets.Find(Interface))
+	{
+		return *Bucket;
+	}
+
+	FActorBucket& Bucket = InterfaceBuckets.Add(Interface);
+	BuildBucket(Bucket, [Interface](const AActor* Actor)
+	{
+		return Actor->GetClass()->ImplementsInterface(Interface);
+	});
+
+	return Bucket;
+}
+
+UTCU_ActorIndexSubsystem::FActorBucket& UTCU_ActorIndexSubsystem::FindOrBuildTagBucket(UClass* ActorClass, FName Tag)
+{
+	if (!ActorClass)
+	{
+		ActorClass = AActor::StaticClass();
+	}
+
+	const FTagBucketKey Key(Tag, ActorClass);
+	if (FActorBucket* Bucket = TagBuckets.Find(Key))
+	{
+		return *Bucket;
+	}
+
+	FActorBucket& Bucket = TagBuckets.Add(Key);
+	BuildBucket(Bucket, [ActorClass, Tag](const AActor* Actor)
+	{
+		return Actor->IsA(ActorClass) && Actor->ActorHasTag(Tag);
+	});
+
+	return Bucket;
+}
+
+template<typename PredicateType>
+void UTCU_ActorIndexSubsystem::BuildBucket(FActorBucket& Bucket, PredicateType Predicate)
+{
+	UWorld* World = GetWorld();
+	for (FActorIterator It(World); It; ++It)
+	{
+		AActor* Actor = *It;
+		if (Predicate(Actor))
+		{
+			Bucket.Actors.Add(Actor);
+		}
+	}
+
+	for (const ULevel* Level : World->GetLevels())
+	{
+		if (IsValid(Level) && Level->bIsVisible)
+		{
+			Bucket.IndexedLevels.Add(Level);
+		}
+	}
+}
+
+AActor* UTCU_ActorIndexSubsystem::GetFirstValidActor(FActorBucket& Bucket)
+{
+	// Drop whatever went stale without us being notified, e.g. actors garbage collected along with their level
+	while (!Bucket.Actors.IsEmpty())
+	{
+		AActor* Actor = Bucket.Actors.Last().Get();
+		if (IsValid(Actor))
+		{
+			return Actor;
+		}
+
+		Bucket.Actors.Pop();
+	}
+
+	return nullptr;
+}
+
+AActor* UTCU_ActorIndexSubsystem::GetFirstValidTaggedActor(FActorBucket& Bucket, FName Tag)
+{
+	while (!Bucket.Actors.IsEmpty())
+	{
+		AActor* Actor = Bucket.Actors.Last().Get();
+		if (IsValid(Actor) && Actor->ActorHasTag(Tag))
+		{
+			return Actor;
+		}
+
+		Bucket.Actors.Pop();
+	}
+
+	return nullptr;
+}
+
+bool UTCU_ActorIndexSubsystem::ImplementsInterface(const AActor* Actor, const TObjectKey<UClass>& Interface)
+{
+	return Actor->GetClass()->ImplementsInterface(Interface.ResolveObjectPtr());
+}
+
+bool UTCU_ActorIndexSubsystem::MatchesTagKey(const AActor* Actor, const FTagBucketKey& Key)
+{
+	return Actor->IsA(Key.Value.ResolveObjectPtr()) && Actor->ActorHasTag(Key.Key);
+}
+
+void UTCU_ActorIndexSubsystem::AddActor(AActor* Actor)
+{
+	for (auto& [Interface, Bucket] : InterfaceBuckets)
+	{
+		if (ImplementsInterface(Actor, Interface))
+		{
+			Bucket.Actors.Add(Actor);
+		}
+	}
+
+	for (auto& [Key, Bucket] : TagBuckets)
+	{
+		if (MatchesTagKey(Actor, Key))
+		{
+			Bucket.Actors.Add(Actor);
+		}
+	}
+}
+
+void UTCU_ActorIndexSubsystem::RemoveActor(AActor* Actor)
+{
+	for (auto& [Interface, Bucket] : InterfaceBuckets)
+	{
+		if (ImplementsInterface(Actor, Interface))
+		{
+			Bucket.Actors.RemoveSingleSwap(Actor);
+		}
+	}
+
+	for (auto& [Key, Bucket] : TagBuckets)
+	{
+		// Don't check the tag, it might have been removed since the actor was indexed
+		if (Actor->IsA(Key.Value.ResolveObjectPtr()))
+		{
+			Bucket.Actors.RemoveSingleSwap(Actor);
+		}
+	}
+}
+
+void UTCU_ActorIndexSubsystem::OnActorSpawned(AActor* Actor)
+{
+	if (IsValid(Actor))
+	{
+		AddActor(Actor);
+	}
+}
+
+void UTCU_ActorIndexSubsystem::OnActorDestroyed(AActor* Actor)
+{
+	if (Actor)
+	{
+		RemoveActor(Actor);
+	}
+}
+
+void UTCU_ActorIndexSubsystem::OnLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+	if (World != GetWorld() || !IsValid(Level))
+	{
+		return;
+	}
+
+	auto IndexLevel = [Level](FActorBucket& Bucket, auto Predicate)
+	{
+		bool bAlreadyIndexed = false;
+		Bucket.IndexedLevels.Add(Level, &bAlreadyIndexed);
+		if (bAlreadyIndexed)
+		{
+			return;
+		}
+
+		for (AActor* Actor : Level->Actors)
+		{
+			if (IsValid(Actor) && Predicate(Actor))
+			{
+				Bucket.Actors.Add(Actor);
+			}
+		}
+	};
+
+	for (auto& [Interface, Bucket] : InterfaceBuckets)
+	{
+		IndexLevel(Bucket, [&Interface](const AActor* Actor) { return ImplementsInterface(Actor, Interface); });
+	}
+
+	for (auto& [Key, Bucket] : TagBuckets)
+	{
+		IndexLevel(Bucket, [&Key](const AActor* Actor) { return MatchesTagKey(Actor, Key); });
+	}
+}
+
+void UTCU_ActorIndexSubsystem::OnLevelRemovedFromWorld(ULevel* Level, UWorld* World)
+{
+	if (World != GetWorld())
+	{
+		return;
+	}
+
+	// Null level means that the whole world is being cleaned up
+	if (!Level)
+	{
+		InterfaceBuckets.Empty();
+		TagBuckets.Empty();
+		return;
+	}
+
+	auto UnindexLevel = [Level](FActorBucket& Bucket)
+	{
+		Bucket.IndexedLevels.Remove(Level);
+		Bucket.Actors.RemoveAllSwap([Level](const TWeakObjectPtr<AActor>& Actor)
+		{
+			const AActor* ValidActor = Actor.Get();
+			return !ValidActor || ValidActor->GetLevel() == Level;
+		});
+	};
+
+	for (auto& [Interface, Bucket] : InterfaceBuckets)
+	{
+		UnindexLevel(Bucket);
+	}
+
+	for (auto& [Key, Bucket] : TagBuckets)
+	{
+		UnindexLevel(Bucket);
+	}
+}
@@ -0,0 +1,57 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+#include "System/TCU_ActorIndexSubsystem.h"
+#include "System/TCU_Library.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTCU_ActorIndexDirectTagEditTest, "TCU.ActorIndex.DirectTagEdit",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FTCU_ActorIndexDirectTagEditTest::RunTest(const FString& Parameters)
+{
+	static const FName Tag = TEXT("TCU_DirectTagEdit");
+
+	UTCU_Settings* Settings = GetMutableDefault<UTCU_Settings>();
+	const bool bUsedActorIndex = Settings->bUseActorIndex;
+	const bool bUsedActorTagIndex = Settings->bUseActorTagIndex;
+	Settings->bUseActorIndex = true;
+	Settings->bUseActorTagIndex = false;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	AActor* Actor = World->SpawnActor<AActor>();
+
+	// Build the tag bucket before the tag is added, as a query made earlier in the game would
+	if (UTCU_ActorIndexSubsystem* ActorIndex = UTCU_ActorIndexSubsystem::Get(World))
+	{
+		TestNull(TEXT("Untagged actor in the index"), ActorIndex->GetActorWithTag(AActor::StaticClass(), Tag));
+	}
+
+	Actor->Tags.Add(Tag);
+
+	TestEqual(TEXT("Actor with directly added tag"),
+		UTCU_Library::GetActorOfClassWithTag(World, AActor::StaticClass(), Tag), Actor);
+	TestEqual(TEXT("Actors with directly added tag"),
+		UTCU_Library::GetActorsOfClassWithTag(World, AActor::StaticClass(), Tag).Num(), 1);
+
+	// Once opted in, direct edits are found as long as they're reported
+	Settings->bUseActorTagIndex = true;
+	if (UTCU_ActorIndexSubsystem* ActorIndex = UTCU_ActorIndexSubsystem::Get(World))
+	{
+		ActorIndex->NotifyActorTagsChanged(Actor);
+	}
+
+	TestEqual(TEXT("Indexed actor with reported tag"),
+		UTCU_Library::GetActorOfClassWithTag(World, AActor::StaticClass(), Tag), Actor);
+
+	Settings->bUseActorIndex = bUsedActorIndex;
+	Settings->bUseActorTagIndex = bUsedActorTagIndex;
+
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif
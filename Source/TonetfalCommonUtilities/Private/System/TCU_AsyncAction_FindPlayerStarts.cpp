@@ -0,0 +1,57 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#include "System/TCU_AsyncAction_FindPlayerStarts.h"
+
+#include "Algo/Count.h"
+#include "GameFramework/PlayerController.h"
+#include "System/TCU_PlayerStartSubsystem.h"
+
+UTCU_AsyncAction_FindPlayerStarts* UTCU_AsyncAction_FindPlayerStarts::FindPlayerStartsAsync(
+	const UObject* WorldContextObject, const TArray<APlayerController*>& Controllers, const FString& IncomingName,
+	TSubclassOf<APawn> PawnClass)
+{
+	auto* Action = NewObject<ThisClass>();
+	Action->WeakContextObject = WorldContextObject;
+	Action->WeakControllers.Append(Controllers);
+	Action->PlayerStartName = IncomingName;
+	Action->PawnToSpawnClass = PawnClass;
+	Action->RegisterWithGameInstance(WorldContextObject);
+
+	return Action;
+}
+
+void UTCU_AsyncAction_FindPlayerStarts::Activate()
+{
+	Super::Activate();
+
+	UTCU_PlayerStartSubsystem* PlayerStartSubsystem = UTCU_PlayerStartSubsystem::Get(WeakContextObject.Get());
+	if (!IsValid(PlayerStartSubsystem))
+	{
+		OnPlayerStartsFound({});
+		return;
+	}
+
+	const int32 ValidControllersNum = Algo::CountIf(WeakControllers,
+		[](const TWeakObjectPtr<APlayerController>& Controller) { return Controller.IsValid(); });
+
+	PlayerStartSubsystem->FindPlayerStartsAsync(ValidControllersNum, PlayerStartName, PawnToSpawnClass,
+		FTCU_OnPlayerStartsFound::CreateUObject(this, &ThisClass::OnPlayerStartsFound));
+}
+
+void UTCU_AsyncAction_FindPlayerStarts::OnPlayerStartsFound(const TArray<APlayerStart*>& PlayerStarts)
+{
+	TArray<APlayerController*> ResolvedControllers;
+	ResolvedControllers.Reserve(WeakControllers.Num());
+
+	for (const TWeakObjectPtr<APlayerController>& Controller : WeakControllers)
+	{
+		ResolvedControllers.Add(Controller.Get());
+	}
+
+	// Controllers that went away in the meantime don't get a player start
+	TArray<APlayerStart*> ControllerPlayerStarts;
+	UTCU_PlayerStartSubsystem::SpreadOverControllers(ResolvedControllers, PlayerStarts, OUT ControllerPlayerStarts);
+
+	OnCompleted.Broadcast(ControllerPlayerStarts);
+	SetReadyToDestroy();
+}
@@ -0,0 +1,35 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#include "System/TCU_AsyncAction_LoadGameFromSlot.h"
+
+#include "System/TCU_SaveGameStorage.h"
+
+UTCU_AsyncAction_LoadGameFromSlot* UTCU_AsyncAction_LoadGameFromSlot::LoadGameFromSlotAsync(
+	const UObject* WorldContextObject, const FString& SlotName)
+{
+	auto* Action = NewObject<ThisClass>();
+	Action->LoadSlotName = SlotName;
+	Action->RegisterWithGameInstance(WorldContextObject);
+
+	return Action;
+}
+
+void UTCU_AsyncAction_LoadGameFromSlot::Activate()
+{
+	Super::Activate();
+
+	FTCU_SaveGameStorage::LoadGameFromSlotAsync(LoadSlotName,
+		[WeakThis = TWeakObjectPtr<ThisClass>(this)](USaveGame* SaveGame)
+		{
+			if (ThisClass* Action = WeakThis.Get())
+			{
+				Action->OnLoaded(SaveGame);
+			}
+		});
+}
+
+void UTCU_AsyncAction_LoadGameFromSlot::OnLoaded(USaveGame* SaveGame)
+{
+	OnCompleted.Broadcast(SaveGame);
+	SetReadyToDestroy();
+}
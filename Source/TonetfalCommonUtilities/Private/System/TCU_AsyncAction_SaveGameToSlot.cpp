@@ -0,0 +1,44 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#include "System/TCU_AsyncAction_SaveGameToSlot.h"
+
+#include "Async/Async.h"
+
+UTCU_AsyncAction_SaveGameToSlot* UTCU_AsyncAction_SaveGameToSlot::SaveGameToSlotAsync(
+	const UObject* WorldContextObject, USaveGame* SaveGame, const FString& SlotName,
+	ETCU_SaveGameCompression Compression)
+{
+	auto* Action = NewObject<ThisClass>();
+	Action->SaveGameObject = SaveGame;
+	Action->SaveSlotName = SlotName;
+	Action->SaveCompression = Compression;
+	Action->RegisterWithGameInstance(WorldContextObject);
+
+	return Action;
+}
+
+void UTCU_AsyncAction_SaveGameToSlot::Activate()
+{
+	Super::Activate();
+
+	TFuture<bool> Future = FTCU_SaveGameStorage::SaveGameToSlotAsync(SaveGameObject, SaveSlotName, SaveCompression);
+	SaveGameObject = nullptr;
+
+	// The future is fulfilled by a worker thread, while Blueprints can only be notified on the game thread
+	Future.Next([WeakThis = TWeakObjectPtr<ThisClass>(this)](bool bSuccess)
+	{
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, bSuccess]()
+		{
+			if (ThisClass* Action = WeakThis.Get())
+			{
+				Action->OnSaved(bSuccess);
+			}
+		});
+	});
+}
+
+void UTCU_AsyncAction_SaveGameToSlot::OnSaved(bool bSuccess)
+{
+	OnCompleted.Broadcast(bSuccess);
+	SetReadyToDestroy();
+}
@@ -0,0 +1,195 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#include "System/TCU_Cooldowns.h"
+
+#include "System/TCU_Library.h"
+
+FTCU_Cooldowns::FTCU_Cooldowns(ETCU_TimeDomain InTimeDomain)
+	: TimeDomain(InTimeDomain)
+{
+}
+
+void FTCU_Cooldowns::Update(const UObject* ContextObject)
+{
+	if (LastUpdateFrame == GFrameCounter)
+	{
+		return;
+	}
+
+	LastUpdateFrame = GFrameCounter;
+
+	switch (TimeDomain)
+	{
+	case ETCU_TimeDomain::Local:
+		Now = UTCU_Library::GetTimestamp(ContextObject);
+		break;
+	case ETCU_TimeDomain::Server:
+		Now = UTCU_Library::GetTimestamp_Server(ContextObject);
+		break;
+	case ETCU_TimeDomain::ServerSmoothed:
+		Now = UTCU_Library::GetTimestamp_Server_Smoothed(ContextObject);
+		break;
+	default:
+		checkNoEntry();
+	}
+}
+
+void FTCU_Cooldowns::SetNow(FTCU_Timestamp InNow)
+{
+	Now = InNow;
+}
+
+FTCU_Timestamp FTCU_Cooldowns::GetNow() const
+{
+	return Now;
+}
+
+ETCU_TimeDomain FTCU_Cooldowns::GetTimeDomain() const
+{
+	return TimeDomain;
+}
+
+FTCU_CooldownHandle FTCU_Cooldowns::Start(double Duration)
+{
+	int32 Index;
+	if (FreeIndices.IsEmpty())
+	{
+		Index = ExpiryTicks.Add(0);
+		Serials.Add(1);
+		AliveFlags.Add(false);
+		PendingFlags.Add(false);
+	}
+	else
+	{
+		Index = FreeIndices.Pop();
+	}
+
+	AliveFlags[Index] = true;
+	AliveNum++;
+
+	const FTCU_CooldownHandle Handle { Index, Serials[Index] };
+	Restart(Handle, Duration);
+	return Handle;
+}
+
+void FTCU_Cooldowns::Restart(FTCU_CooldownHandle Handle, double Duration)
+{
+	if (!IsAlive(Handle))
+	{
+		return;
+	}
+
+	ExpiryTicks[Handle.Index] = Now.Ticks + FTCU_Timestamp::FromSeconds(Duration).Ticks;
+	PendingFlags[Handle.Index] = true;
+	PushExpiry(Handle.Index);
+}
+
+void FTCU_Cooldowns::Remove(FTCU_CooldownHandle Handle)
+{
+	if (!IsAlive(Handle))
+	{
+		return;
+	}
+
+	// Bumping the serial invalidates the outstanding handles as well as the heap entries of the slot
+	Serials[Handle.Index]++;
+	AliveFlags[Handle.Index] = false;
+	PendingFlags[Handle.Index] = false;
+	FreeIndices.Add(Handle.Index);
+	AliveNum--;
+
+	CompactHeapIfNeeded();
+}
+
+bool FTCU_Cooldowns::Contains(FTCU_CooldownHandle Handle) const
+{
+	return IsAlive(Handle);
+}
+
+bool FTCU_Cooldowns::IsReady(FTCU_CooldownHandle Handle) const
+{
+	return !IsAlive(Handle) || ExpiryTicks[Handle.Index] <= Now.Ticks;
+}
+
+double FTCU_Cooldowns::GetRemainingTime(FTCU_CooldownHandle Handle) const
+{
+	if (IsReady(Handle))
+	{
+		return 0.0;
+	}
+
+	return FTCU_Timestamp(ExpiryTicks[Handle.Index] - Now.Ticks).ToSeconds();
+}
+
+void FTCU_Cooldowns::CollectExpired(TArray<FTCU_CooldownHandle>& OutExpired)
+{
+	while (!ExpiryHeap.IsEmpty() && ExpiryHeap.HeapTop().ExpiryTicks <= Now.Ticks)
+	{
+		FHeapEntry Entry;
+		ExpiryHeap.HeapPop(Entry);
+
+		const bool bStale = Serials[Entry.Index] != Entry.Serial || ExpiryTicks[Entry.Index] != Entry.ExpiryTicks;
+		if (bStale || !PendingFlags[Entry.Index])
+		{
+			continue;
+		}
+
+		PendingFlags[Entry.Index] = false;
+		OutExpired.Add({ Entry.Index, Entry.Serial });
+	}
+}
+
+int32 FTCU_Cooldowns::Num() const
+{
+	return AliveNum;
+}
+
+void FTCU_Cooldowns::Reset()
+{
+	// Keep the serials so that handles given out before the reset don't match the new cooldowns
+	for (int32 Index = 0; Index < Serials.Num(); Index++)
+	{
+		if (AliveFlags[Index])
+		{
+			Serials[Index]++;
+			AliveFlags[Index] = false;
+			PendingFlags[Index] = false;
+			FreeIndices.Add(Index);
+		}
+	}
+
+	ExpiryHeap.Reset();
+	AliveNum = 0;
+}
+
+bool FTCU_Cooldowns::IsAlive(FTCU_CooldownHandle Handle) const
+{
+	return Serials.IsValidIndex(Handle.Index) && Serials[Handle.Index] == Handle.Serial && AliveFlags[Handle.Index];
+}
+
+void FTCU_Cooldowns::PushExpiry(int32 Index)
+{
+	ExpiryHeap.HeapPush({ ExpiryTicks[Index], Index, Serials[Index] });
+	CompactHeapIfNeeded();
+}
+
+void FTCU_Cooldowns::CompactHeapIfNeeded()
+{
+	// Each pending cooldown has exactly one up to date entry, everything above that is stale
+	static constexpr int32 MinHeapSizeToCompact = 64;
+	if (ExpiryHeap.Num() < MinHeapSizeToCompact || ExpiryHeap.Num() < AliveNum * 2)
+	{
+		return;
+	}
+
+	ExpiryHeap.Reset();
+	for (int32 Index = 0; Index < ExpiryTicks.Num(); Index++)
+	{
+		if (AliveFlags[Index] && PendingFlags[Index])
+		{
+			ExpiryHeap.Add({ ExpiryTicks[Index], Index, Serials[Index] });
+		}
+	}
+
+	ExpiryHeap.Heapify();
+}
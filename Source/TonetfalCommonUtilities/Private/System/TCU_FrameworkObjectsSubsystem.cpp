@@ -0,0 +1,202 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#include "System/TCU_FrameworkObjectsSubsystem.h"
+
+#include "Engine/World.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/WorldSettings.h"
+#include "System/TCU_WorldResolver.h"
+
+UTCU_FrameworkObjectsSubsystem* UTCU_FrameworkObjectsSubsystem::Get(const UObject* ContextObject)
+{
+	const UWorld* World = FTCU_WorldResolver::Resolve(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	return IsValid(World) ? World->GetSubsystem<ThisClass>() : nullptr;
+}
+
+UObject* UTCU_FrameworkObjectsSubsystem::GetObjectOfClass(const UObject* ContextObject, ETCU_FrameworkObject Type,
+	const UClass* Class)
+{
+	const UWorld* World = FTCU_WorldResolver::Resolve(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (!IsValid(World))
+	{
+		return nullptr;
+	}
+
+	if (ThisClass* Subsystem = World->GetSubsystem<ThisClass>())
+	{
+		return Subsystem->GetObjectOfClass(Type, Class);
+	}
+
+	UObject* Object = FetchObject(World, Type);
+	return IsValid(Object) && Class && Object->IsA(Class) ? Object : nullptr;
+}
+
+UObject* UTCU_FrameworkObjectsSubsystem::GetObject(const UObject* ContextObject, ETCU_FrameworkObject Type)
+{
+	const UWorld* World = FTCU_WorldResolver::Resolve(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (!IsValid(World))
+	{
+		return nullptr;
+	}
+
+	if (ThisClass* Subsystem = World->GetSubsystem<ThisClass>())
+	{
+		return Subsystem->GetObject(Type);
+	}
+
+	UObject* Object = FetchObject(World, Type);
+	return IsValid(Object) ? Object : nullptr;
+}
+
+void UTCU_FrameworkObjectsSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	UWorld* World = GetWorld();
+	check(IsValid(World));
+
+	GameModeInitializedHandle = FGameModeEvents::GameModeInitializedEvent.AddUObject(this,
+		&ThisClass::OnGameModeInitialized);
+	GameStateSetHandle = World->GameStateSetEvent.AddUObject(this, &ThisClass::OnGameStateSet);
+	SeamlessTravelTransitionHandle = FWorldDelegates::OnSeamlessTravelTransition.AddUObject(this,
+		&ThisClass::OnSeamlessTravelTransition);
+}
+
+void UTCU_FrameworkObjectsSubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GameStateSetEvent.Remove(GameStateSetHandle);
+	}
+
+	FGameModeEvents::GameModeInitializedEvent.Remove(GameModeInitializedHandle);
+	FWorldDelegates::OnSeamlessTravelTransition.Remove(SeamlessTravelTransitionHandle);
+
+	InvalidateAll();
+
+	Super::Deinitialize();
+}
+
+UObject* UTCU_FrameworkObjectsSubsystem::GetObjectOfClass(ETCU_FrameworkObject Type, const UClass* Class)
+{
+	if (!Class)
+	{
+		return nullptr;
+	}
+
+	// The cache is only used on the game thread; other threads fetch the object anew
+	if (!IsInGameThread())
+	{
+		UObject* Object = FetchObject(GetWorld(), Type);
+		return IsValid(Object) && Object->IsA(Class) ? Object : nullptr;
+	}
+
+	FCachedObject& CachedObject = CachedObjects[static_cast<int32>(Type)];
+
+	UObject* Object = GetCachedObject(CachedObject, Type);
+	if (!Object)
+	{
+		return nullptr;
+	}
+
+	const TObjectKey<UClass> ClassKey(Class);
+	for (const FClassMatch& ClassMatch : CachedObject.ClassMatches)
+	{
+		if (ClassMatch.Class == ClassKey)
+		{
+			return ClassMatch.bMatches ? Object : nullptr;
+		}
+	}
+
+	const bool bMatches = Object->IsA(Class);
+	CachedObject.ClassMatches.Add({ ClassKey, bMatches });
+	return bMatches ? Object : nullptr;
+}
+
+UObject* UTCU_FrameworkObjectsSubsystem::GetObject(ETCU_FrameworkObject Type)
+{
+	if (!IsInGameThread())
+	{
+		UObject* Object = FetchObject(GetWorld(), Type);
+		return IsValid(Object) ? Object : nullptr;
+	}
+
+	return GetCachedObject(CachedObjects[static_cast<int32>(Type)], Type);
+}
+
+void UTCU_FrameworkObjectsSubsystem::Invalidate(ETCU_FrameworkObject Type)
+{
+	FCachedObject& CachedObject = CachedObjects[static_cast<int32>(Type)];
+	CachedObject.Object.Reset();
+	CachedObject.ClassMatches.Reset();
+}
+
+void UTCU_FrameworkObjectsSubsystem::InvalidateAll()
+{
+	for (int32 Index = 0; Index < static_cast<int32>(ETCU_FrameworkObject::Num); Index++)
+	{
+		Invalidate(static_cast<ETCU_FrameworkObject>(Index));
+	}
+}
+
+UObject* UTCU_FrameworkObjectsSubsystem::FetchObject(const UWorld* World, ETCU_FrameworkObject Type)
+{
+	switch (Type)
+	{
+	case ETCU_FrameworkObject::GameMode:
+		return World->GetAuthGameMode();
+	case ETCU_FrameworkObject::GameState:
+		return World->GetGameState();
+	case ETCU_FrameworkObject::GameSession:
+	{
+		const AGameModeBase* GameMode = World->GetAuthGameMode();
+		return IsValid(GameMode) ? GameMode->GameSession : nullptr;
+	}
+	case ETCU_FrameworkObject::GameInstance:
+		return World->GetGameInstance();
+	case ETCU_FrameworkObject::WorldSettings:
+		return World->GetWorldSettings();
+	default:
+		checkNoEntry();
+		return nullptr;
+	}
+}
+
+UObject* UTCU_FrameworkObjectsSubsystem::GetCachedObject(FCachedObject& CachedObject, ETCU_FrameworkObject Type)
+{
+	UObject* Object = CachedObject.Object.Get();
+	if (!Object)
+	{
+		// Missing objects aren't cached, so that the ones that show up later are picked up without an invalidation
+		Object = FetchObject(GetWorld(), Type);
+		if (!IsValid(Object))
+		{
+			return nullptr;
+		}
+
+		CachedObject.Object = Object;
+		CachedObject.ClassMatches.Reset();
+	}
+
+	return Object;
+}
+
+void UTCU_FrameworkObjectsSubsystem::OnGameModeInitialized(AGameModeBase* GameMode)
+{
+	if (IsValid(GameMode) && GameMode->GetWorld() == GetWorld())
+	{
+		Invalidate(ETCU_FrameworkObject::GameMode);
+		Invalidate(ETCU_FrameworkObject::GameSession);
+	}
+}
+
+void UTCU_FrameworkObjectsSubsystem::OnGameStateSet(AGameStateBase* GameState)
+{
+	Invalidate(ETCU_FrameworkObject::GameState);
+}
+
+void UTCU_FrameworkObjectsSubsystem::OnSeamlessTravelTransition(UWorld* World)
+{
+	InvalidateAll();
+}
@@ -2,8 +2,10 @@
 
 #include "System/TCU_Library.h"
 
+#include "Algo/AllOf.h"
+#include "Algo/AnyOf.h"
+#include "Algo/Count.h"
 #include "Blueprint/UserWidget.h"
-#include "Engine/PlayerStartPIE.h"
 #include "EngineUtils.h"
 #include "GameFramework/GameModeBase.h"
 #include "GameFramework/GameSession.h"
@@ -11,6 +13,12 @@
 #include "GameFramework/PlayerStart.h"
 #include "GameFramework/PlayerState.h"
 #include "Kismet/GameplayStatics.h"
+#include "System/TCU_ActorIndexSubsystem.h"
+#include "System/TCU_PlayerRosterSubsystem.h"
+#include "System/TCU_PlayerStartSubsystem.h"
+#include "System/TCU_ServerClockSubsystem.h"
+#include "System/TCU_StringKernels.h"
+#include "System/TCU_WorldResolver.h"
 #include "Windows/WindowsPlatformApplicationMisc.h"
 
 #define LOCTEXT_NAMESPACE "TonetfalCommonUtilities"
@@ -20,34 +28,32 @@
 AGameStateBase* UTCU_Library::GetTypedGameState(const UObject* ContextObject,
 	TSubclassOf<AGameStateBase> Class)
 {
-	AGameStateBase* GameState = UGameplayStatics::GetGameState(ContextObject);
-	return IsValid(GameState) && GameState->IsA(Class) ? GameState : nullptr;
+	UObject* GameState = UTCU_FrameworkObjectsSubsystem::GetObjectOfClass(ContextObject,
+		ETCU_FrameworkObject::GameState, Class);
+	return static_cast<AGameStateBase*>(GameState);
 }
 
 AGameModeBase* UTCU_Library::GetTypedGameMode(const UObject* ContextObject,
 	TSubclassOf<AGameModeBase> Class)
 {
-	AGameModeBase* GameMode = UGameplayStatics::GetGameMode(ContextObject);
-	return IsValid(GameMode) && GameMode->IsA(Class) ? GameMode : nullptr;
+	UObject* GameMode = UTCU_FrameworkObjectsSubsystem::GetObjectOfClass(ContextObject,
+		ETCU_FrameworkObject::GameMode, Class);
+	return static_cast<AGameModeBase*>(GameMode);
 }
 
 AGameSession* UTCU_Library::GetTypedGameSession(const UObject* ContextObject, TSubclassOf<AGameSession> Class)
 {
-	const AGameModeBase* GameMode = UGameplayStatics::GetGameMode(ContextObject);
-	if (!IsValid(GameMode))
-	{
-		return nullptr;
-	}
-
-	AGameSession* GameSession = GameMode->GameSession;
-	return IsValid(GameSession) && GameSession->IsA(Class) ? GameSession : nullptr;
+	UObject* GameSession = UTCU_FrameworkObjectsSubsystem::GetObjectOfClass(ContextObject,
+		ETCU_FrameworkObject::GameSession, Class);
+	return static_cast<AGameSession*>(GameSession);
 }
 
 UGameInstance* UTCU_Library::GetTypedGameInstance(const UObject* ContextObject,
 	TSubclassOf<UGameInstance> Class)
 {
-	UGameInstance* GameInstance = UGameplayStatics::GetGameInstance(ContextObject);
-	return IsValid(GameInstance) && GameInstance->IsA(Class) ? GameInstance : nullptr;
+	UObject* GameInstance = UTCU_FrameworkObjectsSubsystem::GetObjectOfClass(ContextObject,
+		ETCU_FrameworkObject::GameInstance, Class);
+	return static_cast<UGameInstance*>(GameInstance);
 }
 
 AHUD* UTCU_Library::GetTypedHUD(const APlayerController* PlayerController, TSubclassOf<AHUD> Class)
@@ -69,7 +75,7 @@ const AWorldSettings* UTCU_Library::GetWorldSettings(const UObject* ContextObjec
 		return nullptr;
 	}
 
-	const UWorld* World = GEngine->GetWorldFromContextObject(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	const UWorld* World = FTCU_WorldResolver::Resolve(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
 	if (!IsValid(World))
 	{
 		return nullptr;
@@ -86,11 +92,11 @@ APlayerController* UTCU_Library::GetTypedPlayerController(const UObject* Context
 {
 	if (!bLocalOnly)
 	{
-		APlayerController* Controller = UGameplayStatics::GetPlayerController(ContextObject, PlayerIndex);
+		APlayerController* Controller = GetPlayerController(ContextObject, PlayerIndex);
 		return IsValid(Controller) && Controller->IsA(Class) ? Controller : nullptr;
 	}
 
-	const UWorld* World = GEngine->GetWorldFromContextObject(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	const UWorld* World = FTCU_WorldResolver::Resolve(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
 	if (IsValid(World))
 	{
 		for (FConstPlayerControllerIterator Iterator = World->GetPlayerControllerIterator(); Iterator; ++Iterator)
@@ -109,7 +115,7 @@ APlayerController* UTCU_Library::GetTypedPlayerController(const UObject* Context
 ULocalPlayer* UTCU_Library::GetTypedLocalPlayer(const UObject* ContextObject, TSubclassOf<ULocalPlayer> Class,
 	int32 PlayerIndex)
 {
-	const APlayerController* Controller = UGameplayStatics::GetPlayerController(ContextObject, PlayerIndex);
+	const APlayerController* Controller = GetPlayerController(ContextObject, PlayerIndex);
 	if (!IsValid(Controller))
 	{
 		return nullptr;
@@ -132,7 +138,15 @@ AActor* UTCU_Library::GetActorOfClassWithInterface(const UObject* WorldContextOb
 		return nullptr;
 	}
 
-	if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	if (UTCU_Settings::IsActorIndexEnabled())
+	{
+		if (UTCU_ActorIndexSubsystem* ActorIndex = UTCU_ActorIndexSubsystem::Get(WorldContextObject))
+		{
+			return ActorIndex->GetActorWithInterface(Interface);
+		}
+	}
+
+	if (UWorld* World = FTCU_WorldResolver::Resolve(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
 	{
 		for (FActorIterator It(World); It; ++It)
 		{
@@ -158,7 +172,15 @@ AActor* UTCU_Library::GetActorOfClassWithTag(const UObject* WorldContextObject,
 		return nullptr;
 	}
 
-	if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	if (UTCU_Settings::IsActorTagIndexEnabled())
+	{
+		if (UTCU_ActorIndexSubsystem* ActorIndex = UTCU_ActorIndexSubsystem::Get(WorldContextObject))
+		{
+			return ActorIndex->GetActorWithTag(ActorClass, Tag);
+		}
+	}
+
+	if (UWorld* World = FTCU_WorldResolver::Resolve(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
 	{
 		for (TActorIterator It(World, ActorClass); It; ++It)
 		{
@@ -172,42 +194,141 @@ AActor* UTCU_Library::GetActorOfClassWithTag(const UObject* WorldContextObject,
 
 	return nullptr;
 }
-#pragma endregion
 
-#pragma region Player
-TArray<APlayerController*> UTCU_Library::GetPlayerControllers(const UObject* ContextObject, bool bLocalOnly,
-	TSubclassOf<APlayerController> Class)
+template<typename PredicateType>
+static TArray<AActor*> ScanActorsOfClass(const UObject* WorldContextObject, TSubclassOf<AActor> ActorClass,
+	PredicateType Predicate)
 {
-	TArray<APlayerController*> ReturnValue;
+	TArray<AActor*> ReturnValue;
 
-	const UWorld* World = GEngine->GetWorldFromContextObject(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
-	if (IsValid(World))
+	if (UWorld* World = FTCU_WorldResolver::Resolve(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
 	{
-		for (FConstPlayerControllerIterator Iterator = World->GetPlayerControllerIterator(); Iterator; ++Iterator)
+		for (TActorIterator It(World, ActorClass); It; ++It)
 		{
-			APlayerController* PlayerController = Iterator->Get();
-			if (!IsValid(PlayerController))
+			AActor* Actor = *It;
+			if (IsValid(Actor) && Predicate(Actor))
 			{
-				continue;
+				ReturnValue.Add(Actor);
 			}
+		}
+	}
 
-			if (bLocalOnly)
-			{
-				if (!PlayerController->IsLocalController())
-				{
-					continue;
-				}
-			}
+	return ReturnValue;
+}
 
-			if (!PlayerController->IsA(Class))
-			{
-				continue;
-			}
+TArray<AActor*> UTCU_Library::GetActorsOfClassWithTag(const UObject* WorldContextObject,
+	TSubclassOf<AActor> ActorClass, FName Tag)
+{
+	// We do nothing if no tag is provided, rather than giving ALL actors!
+	if (Tag.IsNone())
+	{
+		return {};
+	}
 
-			ReturnValue.Add(PlayerController);
+	if (UTCU_Settings::IsActorTagIndexEnabled())
+	{
+		if (UTCU_ActorIndexSubsystem* ActorIndex = UTCU_ActorIndexSubsystem::Get(WorldContextObject))
+		{
+			TArray<AActor*> ReturnValue;
+			ActorIndex->GetActorsWithTag(ActorClass, Tag, OUT ReturnValue);
+			return ReturnValue;
 		}
 	}
 
+	return ScanActorsOfClass(WorldContextObject, ActorClass, [Tag](const AActor* Actor)
+	{
+		return Actor->ActorHasTag(Tag);
+	});
+}
+
+TArray<AActor*> UTCU_Library::GetActorsWithAllTags(const UObject* WorldContextObject, TSubclassOf<AActor> ActorClass,
+	const TArray<FName>& Tags)
+{
+	if (Tags.IsEmpty())
+	{
+		return {};
+	}
+
+	if (UTCU_Settings::IsActorTagIndexEnabled())
+	{
+		if (UTCU_ActorIndexSubsystem* ActorIndex = UTCU_ActorIndexSubsystem::Get(WorldContextObject))
+		{
+			TArray<AActor*> ReturnValue;
+			ActorIndex->GetActorsWithAllTags(ActorClass, Tags, OUT ReturnValue);
+			return ReturnValue;
+		}
+	}
+
+	return ScanActorsOfClass(WorldContextObject, ActorClass, [&Tags](const AActor* Actor)
+	{
+		return Algo::AllOf(Tags, [Actor](const FName Tag) { return !Tag.IsNone() && Actor->ActorHasTag(Tag); });
+	});
+}
+
+TArray<AActor*> UTCU_Library::GetActorsWithAnyTag(const UObject* WorldContextObject, TSubclassOf<AActor> ActorClass,
+	const TArray<FName>& Tags)
+{
+	if (Tags.IsEmpty())
+	{
+		return {};
+	}
+
+	if (UTCU_Settings::IsActorTagIndexEnabled())
+	{
+		if (UTCU_ActorIndexSubsystem* ActorIndex = UTCU_ActorIndexSubsystem::Get(WorldContextObject))
+		{
+			TArray<AActor*> ReturnValue;
+			ActorIndex->GetActorsWithAnyTag(ActorClass, Tags, OUT ReturnValue);
+			return ReturnValue;
+		}
+	}
+
+	return ScanActorsOfClass(WorldContextObject, ActorClass, [&Tags](const AActor* Actor)
+	{
+		return Algo::AnyOf(Tags, [Actor](const FName Tag) { return !Tag.IsNone() && Actor->ActorHasTag(Tag); });
+	});
+}
+
+void UTCU_Library::AddActorTag(AActor* Actor, FName Tag)
+{
+	if (!IsValid(Actor) || Tag.IsNone() || Actor->Tags.Contains(Tag))
+	{
+		return;
+	}
+
+	Actor->Tags.Add(Tag);
+
+	if (UTCU_ActorIndexSubsystem* ActorIndex = UTCU_ActorIndexSubsystem::Get(Actor))
+	{
+		ActorIndex->NotifyActorTagsChanged(Actor);
+	}
+}
+
+void UTCU_Library::RemoveActorTag(AActor* Actor, FName Tag)
+{
+	if (!IsValid(Actor))
+	{
+		return;
+	}
+
+	// The index drops actors that lost their tags on its own, no need to notify it
+	Actor->Tags.Remove(Tag);
+}
+#pragma endregion
+
+#pragma region Player
+TArray<APlayerController*> UTCU_Library::GetPlayerControllers(const UObject* ContextObject, bool bLocalOnly,
+	TSubclassOf<APlayerController> Class)
+{
+	TArray<APlayerController*> ReturnValue;
+
+	const UWorld* World = FTCU_WorldResolver::Resolve(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (IsValid(World) && IsValid(Class))
+	{
+		const TTCU_PlayerControllerRange<> PlayerControllers(World, bLocalOnly, Class);
+		TCU::Private::AppendRange(PlayerControllers, OUT ReturnValue);
+	}
+
 	return ReturnValue;
 }
 
@@ -216,36 +337,19 @@ TArray<APlayerState*> UTCU_Library::GetPlayerStates(const UObject* ContextObject
 {
 	TArray<APlayerState*> ReturnValue;
 
-	const UWorld* World = GEngine->GetWorldFromContextObject(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
-	if (IsValid(World))
+	const UWorld* World = FTCU_WorldResolver::Resolve(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (IsValid(World) && IsValid(Class))
 	{
-		const AGameStateBase* GameState = World->GetGameState();
-		if (IsValid(GameState))
+		if (UTCU_PlayerRosterSubsystem* PlayerRoster = World->GetSubsystem<UTCU_PlayerRosterSubsystem>())
 		{
-			for (TObjectPtr<APlayerState> PlayerState : GameState->PlayerArray)
-			{
-				if (bLocalOnly)
-				{
-					const APlayerController* PlayerController = PlayerState->GetPlayerController();
-					if (!IsValid(PlayerController))
-					{
-						continue;
-					}
-
-					if (!PlayerController->IsLocalController())
-					{
-						continue;
-					}
-				}
-
-				if (!PlayerState->IsA(Class))
-				{
-					continue;
-				}
-
-				ReturnValue.Add(PlayerState);
-			}
+			const TConstArrayView<APlayerState*> RosterPlayerStates =
+				PlayerRoster->GetPlayerStatesOfClass(Class, bLocalOnly);
+			ReturnValue.Append(RosterPlayerStates.GetData(), RosterPlayerStates.Num());
+			return ReturnValue;
 		}
+
+		const TTCU_PlayerStateRange<> PlayerStates(World, bLocalOnly, Class);
+		TCU::Private::AppendRange(PlayerStates, OUT ReturnValue);
 	}
 
 	return ReturnValue;
@@ -256,42 +360,18 @@ TArray<APawn*> UTCU_Library::GetPlayerPawns(const UObject* ContextObject, bool b
 {
 	TArray<APawn*> ReturnValue;
 
-	const UWorld* World = GEngine->GetWorldFromContextObject(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
-	if (IsValid(World))
+	const UWorld* World = FTCU_WorldResolver::Resolve(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (IsValid(World) && IsValid(Class))
 	{
-		const AGameStateBase* GameState = World->GetGameState();
-		if (IsValid(GameState))
+		if (UTCU_PlayerRosterSubsystem* PlayerRoster = World->GetSubsystem<UTCU_PlayerRosterSubsystem>())
 		{
-			for (TObjectPtr<APlayerState> PlayerState : GameState->PlayerArray)
-			{
-				if (bLocalOnly)
-				{
-					const APlayerController* PlayerController = PlayerState->GetPlayerController();
-					if (!IsValid(PlayerController))
-					{
-						continue;
-					}
-
-					if (!PlayerController->IsLocalController())
-					{
-						continue;
-					}
-				}
-
-				APawn* PlayerPawn = PlayerState->GetPawn();
-				if (!IsValid(PlayerPawn))
-				{
-					continue;
-				}
-
-				if (!PlayerPawn->IsA(Class))
-				{
-					continue;
-				}
-
-				ReturnValue.Add(PlayerPawn);
-			}
+			const TConstArrayView<APawn*> RosterPawns = PlayerRoster->GetPawnsOfClass(Class, bLocalOnly);
+			ReturnValue.Append(RosterPawns.GetData(), RosterPawns.Num());
+			return ReturnValue;
 		}
+
+		const TTCU_PlayerPawnRange<> PlayerPawns(World, bLocalOnly, Class);
+		TCU::Private::AppendRange(PlayerPawns, OUT ReturnValue);
 	}
 
 	return ReturnValue;
@@ -299,6 +379,11 @@ TArray<APawn*> UTCU_Library::GetPlayerPawns(const UObject* ContextObject, bool b
 
 int32 UTCU_Library::GetPlayersNumber(const UObject* ContextObject, bool bLocalOnly)
 {
+	if (UTCU_PlayerRosterSubsystem* PlayerRoster = UTCU_PlayerRosterSubsystem::Get(ContextObject))
+	{
+		return PlayerRoster->GetPlayersNum(bLocalOnly);
+	}
+
 	int32 Count = 0;
 
 	const auto* GameState = GetGameState<AGameStateBase>(ContextObject);
@@ -362,7 +447,7 @@ APlayerController* UTCU_Library::RetrievePlayerController(const ULocalPlayer* Lo
 {
 	if (IsValid(LocalPlayer))
 	{
-		const UWorld* World = GEngine->GetWorldFromContextObject(LocalPlayer, EGetWorldErrorMode::LogAndReturnNull);
+		const UWorld* World = FTCU_WorldResolver::Resolve(LocalPlayer, EGetWorldErrorMode::LogAndReturnNull);
 		APlayerController* PlayerController = LocalPlayer->GetPlayerController(World);
 		return PlayerController;
 	}
@@ -435,35 +520,57 @@ bool UTCU_Library::K2_IsDesignTime(const UUserWidget* Widget)
 #pragma endregion
 
 #pragma region Time
-float UTCU_Library::GetTime(const UObject* ContextObject)
+/** Returns the time of the world the context object belongs to. */
+static double GetWorldTime(const UObject* ContextObject)
 {
-	const UWorld* World = GEngine->GetWorldFromContextObject(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
-	const float Time = IsValid(World) ? World->GetTimeSeconds() : 0.f;
-	return Time;
+	const UWorld* World = FTCU_WorldResolver::Resolve(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	return IsValid(World) ? World->GetTimeSeconds() : 0.0;
 }
 
-float UTCU_Library::TimeSince(const UObject* ContextObject, float Time)
+/** Returns the time of the server as seen by the world the context object belongs to. */
+static double GetServerWorldTime(const UObject* ContextObject)
 {
-	const float TimeSince = GetTime(ContextObject) - Time;
-	return TimeSince;
+	const UWorld* World = FTCU_WorldResolver::Resolve(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	const AGameStateBase* GameState = IsValid(World) ? World->GetGameState() : nullptr;
+	return IsValid(GameState) ? GameState->GetServerWorldTimeSeconds() : 0.0;
 }
 
-float UTCU_Library::GetTime_Server(const UObject* ContextObject)
+/** Returns the smoothed server time of the world the context object belongs to, or the raw one if there's none. */
+static double GetSmoothedServerWorldTime(const UObject* ContextObject)
 {
-	const AGameStateBase* GameState = UGameplayStatics::GetGameState(ContextObject);
-	if (IsValid(GameState))
+	const UWorld* World = FTCU_WorldResolver::Resolve(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (!IsValid(World))
 	{
-		const float ReturnValue = GameState->GetServerWorldTimeSeconds();
-		return ReturnValue;
+		return 0.0;
 	}
 
-	return 0.f;
+	if (const UTCU_ServerClockSubsystem* ServerClock = World->GetSubsystem<UTCU_ServerClockSubsystem>())
+	{
+		return ServerClock->GetServerTime();
+	}
+
+	const AGameStateBase* GameState = World->GetGameState();
+	return IsValid(GameState) ? GameState->GetServerWorldTimeSeconds() : 0.0;
+}
+
+float UTCU_Library::GetTime(const UObject* ContextObject)
+{
+	return static_cast<float>(GetWorldTime(ContextObject));
+}
+
+float UTCU_Library::TimeSince(const UObject* ContextObject, float Time)
+{
+	return static_cast<float>(GetWorldTime(ContextObject) - Time);
+}
+
+float UTCU_Library::GetTime_Server(const UObject* ContextObject)
+{
+	return static_cast<float>(GetServerWorldTime(ContextObject));
 }
 
 float UTCU_Library::TimeSince_Server(const UObject* ContextObject, float Time)
 {
-	const float TimeSince = GetTime_Server(ContextObject) - Time;
-	return TimeSince;
+	return static_cast<float>(GetServerWorldTime(ContextObject) - Time);
 }
 
 float UTCU_Library::GetTime_Explicit(const UObject* ContextObject)
@@ -485,6 +592,151 @@ float UTCU_Library::TimeSince_Server_Explicit(const UObject* ContextObject, floa
 {
 	return TimeSince_Server(ContextObject, Time);
 }
+
+double UTCU_Library::GetTime_Double(const UObject* ContextObject)
+{
+	return GetWorldTime(ContextObject);
+}
+
+double UTCU_Library::TimeSince_Double(const UObject* ContextObject, double Time)
+{
+	return GetWorldTime(ContextObject) - Time;
+}
+
+double UTCU_Library::GetTime_Server_Double(const UObject* ContextObject)
+{
+	return GetServerWorldTime(ContextObject);
+}
+
+double UTCU_Library::TimeSince_Server_Double(const UObject* ContextObject, double Time)
+{
+	return GetServerWorldTime(ContextObject) - Time;
+}
+
+FTCU_Timestamp UTCU_Library::GetTimestamp(const UObject* ContextObject)
+{
+	return FTCU_Timestamp::FromSeconds(GetWorldTime(ContextObject));
+}
+
+int64 UTCU_Library::TicksSince(const UObject* ContextObject, FTCU_Timestamp Timestamp)
+{
+	return GetTimestamp(ContextObject) - Timestamp;
+}
+
+FTCU_Timestamp UTCU_Library::GetTimestamp_Server(const UObject* ContextObject)
+{
+	return FTCU_Timestamp::FromSeconds(GetServerWorldTime(ContextObject));
+}
+
+int64 UTCU_Library::TicksSince_Server(const UObject* ContextObject, FTCU_Timestamp Timestamp)
+{
+	return GetTimestamp_Server(ContextObject) - Timestamp;
+}
+
+double UTCU_Library::GetTime_Double_Explicit(const UObject* ContextObject)
+{
+	return GetTime_Double(ContextObject);
+}
+
+double UTCU_Library::TimeSince_Double_Explicit(const UObject* ContextObject, double Time)
+{
+	return TimeSince_Double(ContextObject, Time);
+}
+
+double UTCU_Library::GetTime_Server_Double_Explicit(const UObject* ContextObject)
+{
+	return GetTime_Server_Double(ContextObject);
+}
+
+double UTCU_Library::TimeSince_Server_Double_Explicit(const UObject* ContextObject, double Time)
+{
+	return TimeSince_Server_Double(ContextObject, Time);
+}
+
+FTCU_Timestamp UTCU_Library::GetTimestamp_Explicit(const UObject* ContextObject)
+{
+	return GetTimestamp(ContextObject);
+}
+
+int64 UTCU_Library::TicksSince_Explicit(const UObject* ContextObject, FTCU_Timestamp Timestamp)
+{
+	return TicksSince(ContextObject, Timestamp);
+}
+
+FTCU_Timestamp UTCU_Library::GetTimestamp_Server_Explicit(const UObject* ContextObject)
+{
+	return GetTimestamp_Server(ContextObject);
+}
+
+int64 UTCU_Library::TicksSince_Server_Explicit(const UObject* ContextObject, FTCU_Timestamp Timestamp)
+{
+	return TicksSince_Server(ContextObject, Timestamp);
+}
+
+double UTCU_Library::GetTime_Server_Smoothed(const UObject* ContextObject)
+{
+	return GetSmoothedServerWorldTime(ContextObject);
+}
+
+double UTCU_Library::TimeSince_Server_Smoothed(const UObject* ContextObject, double Time)
+{
+	return GetSmoothedServerWorldTime(ContextObject) - Time;
+}
+
+FTCU_Timestamp UTCU_Library::GetTimestamp_Server_Smoothed(const UObject* ContextObject)
+{
+	return FTCU_Timestamp::FromSeconds(GetSmoothedServerWorldTime(ContextObject));
+}
+
+int64 UTCU_Library::TicksSince_Server_Smoothed(const UObject* ContextObject, FTCU_Timestamp Timestamp)
+{
+	return GetTimestamp_Server_Smoothed(ContextObject) - Timestamp;
+}
+
+double UTCU_Library::GetTime_Server_Smoothed_Explicit(const UObject* ContextObject)
+{
+	return GetTime_Server_Smoothed(ContextObject);
+}
+
+double UTCU_Library::TimeSince_Server_Smoothed_Explicit(const UObject* ContextObject, double Time)
+{
+	return TimeSince_Server_Smoothed(ContextObject, Time);
+}
+
+FTCU_Timestamp UTCU_Library::GetTimestamp_Server_Smoothed_Explicit(const UObject* ContextObject)
+{
+	return GetTimestamp_Server_Smoothed(ContextObject);
+}
+
+int64 UTCU_Library::TicksSince_Server_Smoothed_Explicit(const UObject* ContextObject, FTCU_Timestamp Timestamp)
+{
+	return TicksSince_Server_Smoothed(ContextObject, Timestamp);
+}
+
+int64 UTCU_Library::Subtract_TimestampTimestamp(FTCU_Timestamp A, FTCU_Timestamp B)
+{
+	return A - B;
+}
+
+bool UTCU_Library::Less_TimestampTimestamp(FTCU_Timestamp A, FTCU_Timestamp B)
+{
+	return A < B;
+}
+
+bool UTCU_Library::Greater_TimestampTimestamp(FTCU_Timestamp A, FTCU_Timestamp B)
+{
+	return A > B;
+}
+
+double UTCU_Library::Conv_TimestampToSeconds(FTCU_Timestamp Timestamp)
+{
+	return Timestamp.ToSeconds();
+}
+
+FTCU_Timestamp UTCU_Library::MakeTimestampFromSeconds(double Seconds)
+{
+	return FTCU_Timestamp::FromSeconds(Seconds);
+}
 #pragma endregion
 
 #pragma region Gameplay Tags
@@ -514,9 +766,17 @@ FString UTCU_Library::GetFormattedTime()
 #pragma endregion
 
 #pragma region Misc
-TArray<UObject*> UTCU_Library::CastArray(TArray<UObject*> Array, TSubclassOf<UObject> Class)
+TArray<UObject*> UTCU_Library::CastArray(const TArray<UObject*>& Array, TSubclassOf<UObject> Class)
 {
-	return Array;
+	TArray<UObject*> Result;
+	Result.Reserve(Array.Num());
+
+	TCU::Private::ForEachOfClass(Array, Class, [&Result](UObject* Object)
+	{
+		Result.Add(Object);
+	});
+
+	return Result;
 }
 
 void UTCU_Library::CppStackTrace(FString Heading)
@@ -549,7 +809,7 @@ void UTCU_Library::SetUnfocusedVolumeMultiplier(float InVolumeMultiplier)
 
 void UTCU_Library::CancelAllLatentActions(UObject* ContextObject)
 {
-	if (UWorld* World = GEngine->GetWorldFromContextObject(ContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	if (UWorld* World = FTCU_WorldResolver::Resolve(ContextObject, EGetWorldErrorMode::LogAndReturnNull))
 	{
 		FLatentActionManager& LatentActionManager = World->GetLatentActionManager();
 		LatentActionManager.RemoveActionsForObject(ContextObject);
@@ -588,82 +848,44 @@ APlayerStart* UTCU_Library::FindPlayerStart(const APlayerController* Controller,
 		return nullptr;
 	}
 
-	UWorld* World = Controller->GetWorld();
-
-	if (!IncomingName.IsEmpty())
+	UTCU_PlayerStartSubsystem* PlayerStartSubsystem = UTCU_PlayerStartSubsystem::Get(Controller);
+	if (!IsValid(PlayerStartSubsystem))
 	{
-		const APawn* PawnToFit = IsValid(PawnClass) ? PawnClass->GetDefaultObject<APawn>() : nullptr;
-
-		const FName IncomingPlayerStartTag = FName(*IncomingName);
-		TArray<APlayerStart*> MatchingPlayerStarts;
-		for (TActorIterator<APlayerStart> It(World); It; ++It)
-		{
-			APlayerStart* PlayerStart = *It;
-			if (PlayerStart && PlayerStart->PlayerStartTag == IncomingPlayerStartTag)
-			{
-				const FVector ActorLocation = PlayerStart->GetActorLocation();
-				const FRotator ActorRotation = PlayerStart->GetActorRotation();
-				const bool bCanFit = !World->EncroachingBlockingGeometry(PawnToFit, ActorLocation, ActorRotation);
-				if (bCanFit)
-				{
-					MatchingPlayerStarts.Add(PlayerStart);
-				}
-				else
-				{
-					UE_LOG(LogGameMode, Log, TEXT("Skipping player start at [%s] because player can't fit in"),
-						*ActorLocation.ToString());
-				}
-			}
-		}
-
-		if (!MatchingPlayerStarts.IsEmpty())
-		{
-			// Get a random player start
-			const int32 RandIndex = FMath::RandRange(0, MatchingPlayerStarts.Num() - 1);
-			return MatchingPlayerStarts[RandIndex];
-		}
+		return nullptr;
 	}
 
-	// Choose a player start
-	APlayerStart* FoundPlayerStart = nullptr;
-	APawn* PawnToFit = PawnClass ? PawnClass->GetDefaultObject<APawn>() : nullptr;
-	TArray<APlayerStart*> UnOccupiedStartPoints;
-	TArray<APlayerStart*> OccupiedStartPoints;
-	for (TActorIterator<APlayerStart> It(World); It; ++It)
-	{
-		APlayerStart* PlayerStart = *It;
+	TArray<APlayerStart*> PlayerStarts;
+	PlayerStartSubsystem->FindPlayerStarts(1, IncomingName, PawnClass, OUT PlayerStarts);
+	return PlayerStarts[0];
+}
 
-		if (PlayerStart->IsA<APlayerStartPIE>())
-		{
-			// Always prefer the first "Play from Here" PlayerStart, if we find one while in PIE mode
-			return FoundPlayerStart;
-		}
+TArray<APlayerStart*> UTCU_Library::FindPlayerStarts(const TArray<APlayerController*>& Controllers,
+	const FString& IncomingName, const TSubclassOf<APawn> PawnClass)
+{
+	TArray<APlayerStart*> ReturnValue;
+	ReturnValue.SetNumZeroed(Controllers.Num());
 
-		FVector ActorLocation = PlayerStart->GetActorLocation();
-		const FRotator ActorRotation = PlayerStart->GetActorRotation();
-		if (!World->EncroachingBlockingGeometry(PawnToFit, ActorLocation, ActorRotation))
-		{
-			UnOccupiedStartPoints.Add(PlayerStart);
-		}
-		else if (World->FindTeleportSpot(PawnToFit, ActorLocation, ActorRotation))
-		{
-			OccupiedStartPoints.Add(PlayerStart);
-		}
+	APlayerController* const* ValidController = Controllers.FindByPredicate(
+		[](const APlayerController* Controller) { return IsValid(Controller); });
+	if (!ValidController)
+	{
+		return ReturnValue;
 	}
 
-	if (!IsValid(FoundPlayerStart))
+	UTCU_PlayerStartSubsystem* PlayerStartSubsystem = UTCU_PlayerStartSubsystem::Get(*ValidController);
+	if (!IsValid(PlayerStartSubsystem))
 	{
-		if (!UnOccupiedStartPoints.IsEmpty())
-		{
-			FoundPlayerStart = UnOccupiedStartPoints[FMath::RandRange(0, UnOccupiedStartPoints.Num() - 1)];
-		}
-		else if (!OccupiedStartPoints.IsEmpty())
-		{
-			FoundPlayerStart = OccupiedStartPoints[FMath::RandRange(0, OccupiedStartPoints.Num() - 1)];
-		}
+		return ReturnValue;
 	}
 
-	return FoundPlayerStart;
+	const int32 ValidControllersNum = Algo::CountIf(Controllers,
+		[](const APlayerController* Controller) { return IsValid(Controller); });
+
+	TArray<APlayerStart*> PlayerStarts;
+	PlayerStartSubsystem->FindPlayerStarts(ValidControllersNum, IncomingName, PawnClass, OUT PlayerStarts);
+	UTCU_PlayerStartSubsystem::SpreadOverControllers(Controllers, PlayerStarts, OUT ReturnValue);
+
+	return ReturnValue;
 }
 
 void UTCU_Library::ClipboardCopy(const FString& String)
@@ -733,62 +955,35 @@ FUniqueNetIdRepl UTCU_Library::GetNetIdFromPawn(const APawn* Pawn)
 #pragma endregion
 
 #pragma region String
-static bool IsSpace(FString::ElementType Character)
-{
-	return Character == ' ' || Character == '\n' || Character == '\r';
-}
-
-FString UTCU_Library::TrimLeadingSpaces(FString InString, bool& bOutHasTrimmed)
+/** Cuts the string down to the given view of itself, if they differ. */
+static FString CutToView(FString&& InString, FStringView View, bool& bOutHasTrimmed)
 {
-	const int32 Count = InString.Len();
-	for (int32 i = 0; i < Count; i++)
+	if (View.Len() != InString.Len())
 	{
-		const FString::ElementType Character = InString[0];
-		if (IsSpace(Character))
-		{
-			InString.RemoveAt(0);
-			bOutHasTrimmed = true;
-		}
-		else
-		{
-			break;
-		}
+		const int32 Start = UE_PTRDIFF_TO_INT32(View.GetData() - *InString);
+		InString.MidInline(Start, View.Len());
+		bOutHasTrimmed = true;
 	}
 
-	return InString;
+	return MoveTemp(InString);
 }
 
-FString UTCU_Library::TrimTrailingSpaces(FString InString, bool& bOutHasTrimmed)
+FString UTCU_Library::TrimLeadingSpaces(FString InString, bool& bOutHasTrimmed, ETCU_WhitespaceSet Whitespace)
 {
-	const int32 Count = InString.Len();
-	for (int32 i = Count - 1; i >= 0; i--)
-	{
-		const FString::ElementType Character = InString[i];
-		if (IsSpace(Character))
-		{
-			InString.RemoveAt(i);
-			bOutHasTrimmed = true;
-		}
-		else
-		{
-			break;
-		}
-	}
-
-	return InString;
+	const FStringView Trimmed = TrimLeadingSpaces(FStringView(InString), Whitespace);
+	return CutToView(MoveTemp(InString), Trimmed, bOutHasTrimmed);
 }
 
-FString UTCU_Library::TrimSurroundingSpaces(FString InString, bool& bOutHasTrimmed)
+FString UTCU_Library::TrimTrailingSpaces(FString InString, bool& bOutHasTrimmed, ETCU_WhitespaceSet Whitespace)
 {
-	bool bTrimmed = false;
-
-	InString = TrimLeadingSpaces(InString, bTrimmed);
-	bOutHasTrimmed |= bTrimmed;
-
-	InString = TrimTrailingSpaces(InString, bTrimmed);
-	bOutHasTrimmed |= bTrimmed;
+	const FStringView Trimmed = TrimTrailingSpaces(FStringView(InString), Whitespace);
+	return CutToView(MoveTemp(InString), Trimmed, bOutHasTrimmed);
+}
 
-	return InString;
+FString UTCU_Library::TrimSurroundingSpaces(FString InString, bool& bOutHasTrimmed, ETCU_WhitespaceSet Whitespace)
+{
+	const FStringView Trimmed = TrimSurroundingSpaces(FStringView(InString), Whitespace);
+	return CutToView(MoveTemp(InString), Trimmed, bOutHasTrimmed);
 }
 
 FString UTCU_Library::LimitString(FString InString, int32 Limit, bool& bOutLimited)
@@ -799,33 +994,194 @@ FString UTCU_Library::LimitString(FString InString, int32 Limit, bool& bOutLimit
 		return InString;
 	}
 
-	FString ReturnValue = InString;
-	ReturnValue.LeftInline(Limit);
+	InString.LeftInline(Limit);
 
 	bOutLimited = true;
-	return ReturnValue;
+	return InString;
 }
 
 FString UTCU_Library::Repeat(FString String, int32 Count)
 {
 	FString ReturnValue;
-	for (int32 i = 0; i < Count; ++i)
-	{
-		ReturnValue += String;
-	}
-
+	AppendRepeated(ReturnValue, String, Count);
 	return ReturnValue;
 }
 #pragma endregion
 #pragma endregion
 
 #pragma region C++
+#pragma region SaveGame
+TFuture<bool> UTCU_Library::SaveGameToSlotAsync(USaveGame* SaveGame, const FString& SlotName,
+	ETCU_SaveGameCompression Compression)
+{
+	return FTCU_SaveGameStorage::SaveGameToSlotAsync(SaveGame, SlotName, Compression);
+}
+
+void UTCU_Library::ReleaseSaveGameObject(USaveGame* SaveGame)
+{
+	UTCU_SaveGamePoolSubsystem::ReleaseSaveGame(SaveGame);
+}
+#pragma endregion
+
 #pragma region Misc
 bool UTCU_Library::IsWorldType(const UObject* ContextObject, EWorldType::Type Type)
 {
 	return IsValid(ContextObject) ? ContextObject->GetWorld()->WorldType == Type : false;
 }
 #pragma endregion
+
+#pragma region String
+/** Grows the string by the given number of characters, and returns where they start. */
+static TCHAR* AppendUninitialized(FString& OutString, int32 Len)
+{
+	TArray<TCHAR, FString::AllocatorType>& CharArray = OutString.GetCharArray();
+	const int32 OldLen = OutString.Len();
+	CharArray.SetNumUninitialized(OldLen + Len + 1);
+	CharArray[OldLen + Len] = TEXT('\0');
+	return CharArray.GetData() + OldLen;
+}
+
+/** Grows the builder by the given number of characters, and returns where they start. */
+static TCHAR* AppendUninitialized(FStringBuilderBase& OutBuilder, int32 Len)
+{
+	const int32 OldLen = OutBuilder.Len();
+	OutBuilder.AddUninitialized(Len);
+	return OutBuilder.GetData() + OldLen;
+}
+
+/** Returns the length of the repeated string, or 0 if there's nothing to write or it wouldn't fit in a string. */
+static int32 GetRepeatedLen(FStringView String, int32 Count)
+{
+	const int64 TotalLen = static_cast<int64>(String.Len()) * FMath::Max(Count, 0);
+	if (!ensureMsgf(TotalLen < MAX_int32, TEXT("Repeated string is too long.")))
+	{
+		return 0;
+	}
+
+	return static_cast<int32>(TotalLen);
+}
+
+template<typename StringType>
+static int32 GetJoinedLen(TConstArrayView<StringType> Strings, FStringView Separator)
+{
+	if (Strings.IsEmpty())
+	{
+		return 0;
+	}
+
+	int64 TotalLen = static_cast<int64>(Separator.Len()) * (Strings.Num() - 1);
+	for (const StringType& String : Strings)
+	{
+		TotalLen += String.Len();
+	}
+
+	if (!ensureMsgf(TotalLen < MAX_int32, TEXT("Joined string is too long.")))
+	{
+		return 0;
+	}
+
+	return static_cast<int32>(TotalLen);
+}
+
+template<typename StringType>
+static void WriteJoined(TCHAR* Dest, TConstArrayView<StringType> Strings, FStringView Separator)
+{
+	for (int32 Index = 0; Index < Strings.Num(); Index++)
+	{
+		if (Index > 0)
+		{
+			FMemory::Memcpy(Dest, Separator.GetData(), Separator.Len() * sizeof(TCHAR));
+			Dest += Separator.Len();
+		}
+
+		const FStringView String = Strings[Index];
+		FMemory::Memcpy(Dest, String.GetData(), String.Len() * sizeof(TCHAR));
+		Dest += String.Len();
+	}
+}
+
+template<typename StringType, typename DestType>
+static void AppendJoinedImpl(DestType& OutDest, TConstArrayView<StringType> Strings, FStringView Separator)
+{
+	const int32 TotalLen = GetJoinedLen(Strings, Separator);
+	if (TotalLen > 0)
+	{
+		WriteJoined(AppendUninitialized(OutDest, TotalLen), Strings, Separator);
+	}
+}
+
+FStringView UTCU_Library::TrimLeadingSpaces(FStringView InString, ETCU_WhitespaceSet Whitespace)
+{
+	return InString.RightChop(
+		TCU::StringKernels::CountLeadingWhitespace(InString.GetData(), InString.Len(), Whitespace));
+}
+
+FStringView UTCU_Library::TrimTrailingSpaces(FStringView InString, ETCU_WhitespaceSet Whitespace)
+{
+	return InString.LeftChop(
+		TCU::StringKernels::CountTrailingWhitespace(InString.GetData(), InString.Len(), Whitespace));
+}
+
+FStringView UTCU_Library::TrimSurroundingSpaces(FStringView InString, ETCU_WhitespaceSet Whitespace)
+{
+	return TrimTrailingSpaces(TrimLeadingSpaces(InString, Whitespace), Whitespace);
+}
+
+bool UTCU_Library::IsSpace(TCHAR Character, ETCU_WhitespaceSet Whitespace)
+{
+	return TCU::StringKernels::IsWhitespace(Character, Whitespace);
+}
+
+void UTCU_Library::AppendRepeated(FString& OutString, FStringView String, int32 Count)
+{
+	const int32 TotalLen = GetRepeatedLen(String, Count);
+	if (TotalLen > 0)
+	{
+		TCU::StringKernels::FillRepeated(AppendUninitialized(OutString, TotalLen), String.GetData(), String.Len(),
+			Count);
+	}
+}
+
+void UTCU_Library::AppendRepeated(FStringBuilderBase& OutBuilder, FStringView String, int32 Count)
+{
+	const int32 TotalLen = GetRepeatedLen(String, Count);
+	if (TotalLen > 0)
+	{
+		TCU::StringKernels::FillRepeated(AppendUninitialized(OutBuilder, TotalLen), String.GetData(), String.Len(),
+			Count);
+	}
+}
+
+void UTCU_Library::AppendJoined(FString& OutString, TConstArrayView<FStringView> Strings, FStringView Separator)
+{
+	AppendJoinedImpl(OutString, Strings, Separator);
+}
+
+void UTCU_Library::AppendJoined(FStringBuilderBase& OutBuilder, TConstArrayView<FStringView> Strings,
+	FStringView Separator)
+{
+	AppendJoinedImpl(OutBuilder, Strings, Separator);
+}
+
+FString UTCU_Library::Join(TConstArrayView<FStringView> Strings, FStringView Separator)
+{
+	FString ReturnValue;
+	AppendJoinedImpl(ReturnValue, Strings, Separator);
+	return ReturnValue;
+}
+
+FString UTCU_Library::Join(TConstArrayView<FString> Strings, FStringView Separator)
+{
+	FString ReturnValue;
+	AppendJoinedImpl(ReturnValue, Strings, Separator);
+	return ReturnValue;
+}
+
+FString UTCU_Library::Concat(TConstArrayView<FStringView> Strings)
+{
+	return Join(Strings, FStringView());
+}
+#pragma endregion
 #pragma endregion
 
 UTCU_Settings::UTCU_Settings()
@@ -847,4 +1203,16 @@ float UTCU_Settings::GetMaxWaitingTime()
 	return This->MaxWaitingTime;
 }
 
+bool UTCU_Settings::IsActorIndexEnabled()
+{
+	const auto* This = GetDefault<ThisClass>();
+	return This->bUseActorIndex;
+}
+
+bool UTCU_Settings::IsActorTagIndexEnabled()
+{
+	const auto* This = GetDefault<ThisClass>();
+	return This->bUseActorIndex && This->bUseActorTagIndex;
+}
+
 #undef LOCTEXT_NAMESPACE
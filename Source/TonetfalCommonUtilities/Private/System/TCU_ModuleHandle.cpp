@@ -0,0 +1,65 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#include "System/TCU_ModuleHandle.h"
+
+#include "Modules/ModuleManager.h"
+
+FTCU_ModuleHandle::FTCU_ModuleHandle(FName InModuleName)
+	: ModuleName(InModuleName)
+	, CachedModule(MakeShared<std::atomic<IModuleInterface*>>(nullptr))
+{
+}
+
+FTCU_ModuleHandle::~FTCU_ModuleHandle()
+{
+	// Handles are usually statics, which are destroyed after the module manager when the engine exits; the handler
+	// only holds on to the cache weakly, so leaving it registered then is harmless
+	if (ModulesChangedHandle.IsValid() && !IsEngineExitRequested())
+	{
+		FModuleManager::Get().OnModulesChanged().Remove(ModulesChangedHandle);
+	}
+}
+
+IModuleInterface* FTCU_ModuleHandle::Get() const
+{
+	IModuleInterface* Module = CachedModule->load(std::memory_order_acquire);
+	if (Module)
+	{
+		return Module;
+	}
+
+	// Modules that aren't loaded yet are looked up over and over, until they are
+	Module = FModuleManager::Get().GetModule(ModuleName);
+
+	// Modules are unloaded on the game thread, so a lookup made elsewhere could race the unload, and cache the pointer
+	// after the handler has dropped it
+	if (Module && IsInGameThread())
+	{
+		if (!ModulesChangedHandle.IsValid())
+		{
+			ModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddLambda(
+				[ModuleName = ModuleName, WeakCachedModule = TWeakPtr<std::atomic<IModuleInterface*>>(CachedModule)]
+				(FName ChangedModuleName, EModuleChangeReason Reason)
+				{
+					if (Reason != EModuleChangeReason::ModuleUnloaded || ChangedModuleName != ModuleName)
+					{
+						return;
+					}
+
+					if (TSharedPtr<std::atomic<IModuleInterface*>> PinnedCachedModule = WeakCachedModule.Pin())
+					{
+						PinnedCachedModule->store(nullptr, std::memory_order_release);
+					}
+				});
+		}
+
+		CachedModule->store(Module, std::memory_order_release);
+	}
+
+	return Module;
+}
+
+FName FTCU_ModuleHandle::GetModuleName() const
+{
+	return ModuleName;
+}
@@ -0,0 +1,369 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#include "System/TCU_PlayerRosterSubsystem.h"
+
+#include "Engine/World.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "System/TCU_WorldResolver.h"
+
+UTCU_PlayerRosterSubsystem* UTCU_PlayerRosterSubsystem::Get(const UObject* ContextObject)
+{
+	const UWorld* World = FTCU_WorldResolver::Resolve(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	return IsValid(World) ? World->GetSubsystem<ThisClass>() : nullptr;
+}
+
+void UTCU_PlayerRosterSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const UWorld* World = GetWorld();
+	check(IsValid(World));
+
+	ActorSpawnedHandle = World->AddOnActorSpawnedHandler(
+		FOnActorSpawned::FDelegate::CreateUObject(this, &ThisClass::OnActorSpawned));
+	ActorDestroyedHandle = World->AddOnActorDestroyedHandler(
+		FOnActorDestroyed::FDelegate::CreateUObject(this, &ThisClass::OnActorDestroyed));
+
+	PostLoginHandle = FGameModeEvents::GameModePostLoginEvent.AddUObject(this, &ThisClass::OnPostLogin);
+	LogoutHandle = FGameModeEvents::GameModeLogoutEvent.AddUObject(this, &ThisClass::OnLogout);
+}
+
+void UTCU_PlayerRosterSubsystem::Deinitialize()
+{
+	if (const UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+		World->RemoveOnActorDestroyededHandler(ActorDestroyedHandle);
+	}
+
+	FGameModeEvents::GameModePostLoginEvent.Remove(PostLoginHandle);
+	FGameModeEvents::GameModeLogoutEvent.Remove(LogoutHandle);
+
+	for (const TWeakObjectPtr<APlayerState>& PlayerState : PlayerStates)
+	{
+		if (PlayerState.IsValid())
+		{
+			PlayerState->OnPawnSet.RemoveAll(this);
+		}
+	}
+
+	Super::Deinitialize();
+}
+
+void UTCU_PlayerRosterSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!bDirty && HasUnnotifiedChanges())
+	{
+		MarkDirty();
+	}
+
+	RefreshIfDirty();
+}
+
+TStatId UTCU_PlayerRosterSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTCU_PlayerRosterSubsystem, STATGROUP_Tickables);
+}
+
+void UTCU_PlayerRosterSubsystem::MarkDirty()
+{
+	bDirty = true;
+}
+
+int32 UTCU_PlayerRosterSubsystem::GetPlayersNum(bool bLocalOnly)
+{
+	RefreshIfDirty();
+	return bLocalOnly ? LocalPlayersNum : PlayerStates.Num();
+}
+
+TConstArrayView<TWeakObjectPtr<APlayerState>> UTCU_PlayerRosterSubsystem::GetPlayerStates()
+{
+	RefreshIfDirty();
+	return PlayerStates;
+}
+
+TConstArrayView<TWeakObjectPtr<APlayerController>> UTCU_PlayerRosterSubsystem::GetControllers()
+{
+	RefreshIfDirty();
+	return Controllers;
+}
+
+TConstArrayView<TWeakObjectPtr<APawn>> UTCU_PlayerRosterSubsystem::GetPawns()
+{
+	RefreshIfDirty();
+	return Pawns;
+}
+
+TConstArrayView<FUniqueNetIdRepl> UTCU_PlayerRosterSubsystem::GetNetIds()
+{
+	RefreshIfDirty();
+	return NetIds;
+}
+
+const TBitArray<>& UTCU_PlayerRosterSubsystem::GetLocalFlags()
+{
+	RefreshIfDirty();
+	return LocalFlags;
+}
+
+TConstArrayView<APawn*> UTCU_PlayerRosterSubsystem::GetPawnsOfClass(const UClass* Class, bool bLocalOnly)
+{
+	RefreshIfDirty();
+
+	const FClassFilterKey Key(Class, bLocalOnly);
+	if (const TArray<APawn*>* CachedPawns = PawnsOfClass.Find(Key))
+	{
+		return *CachedPawns;
+	}
+
+	TArray<APawn*>& FilteredPawns = PawnsOfClass.Add(Key);
+	for (int32 Index = 0; Index < Pawns.Num(); Index++)
+	{
+		if (bLocalOnly && !LocalFlags[Index])
+		{
+			continue;
+		}
+
+		APawn* Pawn = Pawns[Index].Get();
+		if (IsValid(Pawn) && (!Class || Pawn->IsA(Class)))
+		{
+			FilteredPawns.Add(Pawn);
+		}
+	}
+
+	return FilteredPawns;
+}
+
+TConstArrayView<APlayerState*> UTCU_PlayerRosterSubsystem::GetPlayerStatesOfClass(const UClass* Class,
+	bool bLocalOnly)
+{
+	RefreshIfDirty();
+
+	const FClassFilterKey Key(Class, bLocalOnly);
+	if (const TArray<APlayerState*>* CachedPlayerStates = PlayerStatesOfClass.Find(Key))
+	{
+		return *CachedPlayerStates;
+	}
+
+	TArray<APlayerState*>& FilteredPlayerStates = PlayerStatesOfClass.Add(Key);
+	for (int32 Index = 0; Index < PlayerStates.Num(); Index++)
+	{
+		if (bLocalOnly && !LocalFlags[Index])
+		{
+			continue;
+		}
+
+		APlayerState* PlayerState = PlayerStates[Index].Get();
+		if (IsValid(PlayerState) && (!Class || PlayerState->IsA(Class)))
+		{
+			FilteredPlayerStates.Add(PlayerState);
+		}
+	}
+
+	return FilteredPlayerStates;
+}
+
+bool UTCU_PlayerRosterSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UTCU_PlayerRosterSubsystem::RefreshIfDirty()
+{
+	if (bDirty)
+	{
+		Refresh();
+	}
+}
+
+void UTCU_PlayerRosterSubsystem::Refresh()
+{
+	const bool bWasDirty = bDirty;
+	bDirty = false;
+
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	const TArray<TObjectPtr<APlayerState>> EmptyPlayerArray;
+	const TArray<TObjectPtr<APlayerState>>& PlayerArray = IsValid(GameState)
+		? GameState->PlayerArray
+		: EmptyPlayerArray;
+
+	TArray<TWeakObjectPtr<APlayerState>> NewPlayerStates;
+	TArray<TWeakObjectPtr<APlayerController>> NewControllers;
+	TArray<TWeakObjectPtr<APawn>> NewPawns;
+	TArray<FUniqueNetIdRepl> NewNetIds;
+	TBitArray<> NewLocalFlags;
+	TMap<TObjectKey<APlayerState>, int32> NewPlayerIndices;
+	int32 NewLocalPlayersNum = 0;
+
+	NewPlayerStates.Reserve(PlayerArray.Num());
+	NewControllers.Reserve(PlayerArray.Num());
+	NewPawns.Reserve(PlayerArray.Num());
+	NewNetIds.Reserve(PlayerArray.Num());
+	NewLocalFlags.Reserve(PlayerArray.Num());
+	NewPlayerIndices.Reserve(PlayerArray.Num());
+
+	TArray<APlayerState*, TInlineAllocator<16>> AddedPlayers;
+	TArray<APlayerState*, TInlineAllocator<16>> ChangedPlayers;
+
+	for (APlayerState* PlayerState : PlayerArray)
+	{
+		if (!IsValid(PlayerState))
+		{
+			continue;
+		}
+
+		APlayerController* Controller = PlayerState->GetPlayerController();
+		APawn* Pawn = PlayerState->GetPawn();
+		const bool bLocal = IsValid(Controller) && Controller->IsLocalController();
+
+		NewPlayerStates.Add(PlayerState);
+		NewControllers.Add(Controller);
+		NewPawns.Add(Pawn);
+		NewNetIds.Add(PlayerState->GetUniqueId());
+		NewLocalFlags.Add(bLocal);
+		NewLocalPlayersNum += bLocal ? 1 : 0;
+
+		NewPlayerIndices.Add(PlayerState, NewPlayerStates.Num() - 1);
+
+		const int32* OldIndexPtr = PlayerIndices.Find(PlayerState);
+		const int32 OldIndex = OldIndexPtr ? *OldIndexPtr : INDEX_NONE;
+		if (OldIndex == INDEX_NONE)
+		{
+			PlayerState->OnPawnSet.AddUniqueDynamic(this, &ThisClass::OnPlayerStatePawnSet);
+			AddedPlayers.Add(PlayerState);
+		}
+		else if (Controllers[OldIndex] != Controller || Pawns[OldIndex] != Pawn || LocalFlags[OldIndex] != bLocal ||
+			NetIds[OldIndex] != NewNetIds.Last())
+		{
+			ChangedPlayers.Add(PlayerState);
+		}
+	}
+
+	TArray<APlayerState*, TInlineAllocator<16>> RemovedPlayers;
+	for (const TWeakObjectPtr<APlayerState>& OldPlayerState : PlayerStates)
+	{
+		if (!NewPlayerIndices.Contains(OldPlayerState.Get()))
+		{
+			APlayerState* RemovedPlayerState = OldPlayerState.Get();
+			if (IsValid(RemovedPlayerState))
+			{
+				RemovedPlayerState->OnPawnSet.RemoveDynamic(this, &ThisClass::OnPlayerStatePawnSet);
+			}
+
+			RemovedPlayers.Add(RemovedPlayerState);
+		}
+	}
+
+	const bool bChanged = !AddedPlayers.IsEmpty() || !ChangedPlayers.IsEmpty() || !RemovedPlayers.IsEmpty();
+	if (!bChanged && !bWasDirty)
+	{
+		return;
+	}
+
+	PlayerStates = MoveTemp(NewPlayerStates);
+	Controllers = MoveTemp(NewControllers);
+	Pawns = MoveTemp(NewPawns);
+	NetIds = MoveTemp(NewNetIds);
+	LocalFlags = MoveTemp(NewLocalFlags);
+	LocalPlayersNum = NewLocalPlayersNum;
+	PlayerIndices = MoveTemp(NewPlayerIndices);
+
+	PawnsOfClass.Reset();
+	PlayerStatesOfClass.Reset();
+
+	if (!bChanged)
+	{
+		return;
+	}
+
+	for (APlayerState* PlayerState : RemovedPlayers)
+	{
+		OnPlayerRemoved.Broadcast(PlayerState);
+	}
+
+	for (APlayerState* PlayerState : AddedPlayers)
+	{
+		OnPlayerAdded.Broadcast(PlayerState);
+	}
+
+	for (APlayerState* PlayerState : ChangedPlayers)
+	{
+		OnPlayerChanged.Broadcast(PlayerState);
+	}
+
+	OnRosterChanged.Broadcast();
+}
+
+bool UTCU_PlayerRosterSubsystem::HasUnnotifiedChanges() const
+{
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	const int32 PlayerArrayNum = IsValid(GameState) ? GameState->PlayerArray.Num() : 0;
+	if (PlayerArrayNum != PlayerStates.Num())
+	{
+		return true;
+	}
+
+	// Pawns are covered by APlayerState::OnPawnSet, but the owner and the net ID of a player state are replicated
+	// without any notification
+	for (int32 Index = 0; Index < PlayerStates.Num(); Index++)
+	{
+		const APlayerState* PlayerState = PlayerStates[Index].Get();
+		if (!IsValid(PlayerState))
+		{
+			return true;
+		}
+
+		const APlayerController* Controller = PlayerState->GetPlayerController();
+		const bool bLocal = IsValid(Controller) && Controller->IsLocalController();
+		if (Controllers[Index].Get() != Controller || LocalFlags[Index] != bLocal ||
+			NetIds[Index] != PlayerState->GetUniqueId())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UTCU_PlayerRosterSubsystem::OnActorSpawned(AActor* Actor)
+{
+	if (Actor->IsA<APlayerState>() || Actor->IsA<APlayerController>())
+	{
+		MarkDirty();
+	}
+}
+
+void UTCU_PlayerRosterSubsystem::OnActorDestroyed(AActor* Actor)
+{
+	if (Actor->IsA<APlayerState>() || Actor->IsA<APlayerController>() || Actor->IsA<APawn>())
+	{
+		MarkDirty();
+	}
+}
+
+void UTCU_PlayerRosterSubsystem::OnPostLogin(AGameModeBase* GameMode, APlayerController* NewPlayer)
+{
+	if (IsValid(GameMode) && GameMode->GetWorld() == GetWorld())
+	{
+		MarkDirty();
+	}
+}
+
+void UTCU_PlayerRosterSubsystem::OnLogout(AGameModeBase* GameMode, AController* Exiting)
+{
+	if (IsValid(GameMode) && GameMode->GetWorld() == GetWorld())
+	{
+		MarkDirty();
+	}
+}
+
+void UTCU_PlayerRosterSubsystem::OnPlayerStatePawnSet(APlayerState* PlayerState, APawn* NewPawn, APawn* OldPawn)
+{
+	MarkDirty();
+}
@@ -0,0 +1,518 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#include "System/TCU_PlayerStartSubsystem.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "Engine/PlayerStartPIE.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerStart.h"
+#include "System/TCU_WorldResolver.h"
+
+UTCU_PlayerStartSubsystem* UTCU_PlayerStartSubsystem::Get(const UObject* ContextObject)
+{
+	const UWorld* World = FTCU_WorldResolver::Resolve(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	return IsValid(World) ? World->GetSubsystem<ThisClass>() : nullptr;
+}
+
+void UTCU_PlayerStartSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const UWorld* World = GetWorld();
+	check(IsValid(World));
+
+	ActorSpawnedHandle = World->AddOnActorSpawnedHandler(
+		FOnActorSpawned::FDelegate::CreateUObject(this, &ThisClass::OnActorSpawned));
+	ActorDestroyedHandle = World->AddOnActorDestroyedHandler(
+		FOnActorDestroyed::FDelegate::CreateUObject(this, &ThisClass::OnActorDestroyed));
+
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &ThisClass::OnLevelChanged);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &ThisClass::OnLevelChanged);
+}
+
+void UTCU_PlayerStartSubsystem::Deinitialize()
+{
+	if (const UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+		World->RemoveOnActorDestroyededHandler(ActorDestroyedHandle);
+	}
+
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+
+	// Pending requests won't get their results anymore, but their callers still have to be told they're done. They're
+	// moved out first, so that the callbacks can't modify the map while it's iterated
+	TMap<int32, FAsyncRequest> PendingRequests = MoveTemp(AsyncRequests);
+	AsyncRequests.Reset();
+
+	for (TPair<int32, FAsyncRequest>& PendingRequest : PendingRequests)
+	{
+		PendingRequest.Value.OnFound.ExecuteIfBound(TArray<APlayerStart*>());
+	}
+
+	Super::Deinitialize();
+}
+
+void UTCU_PlayerStartSubsystem::FindPlayerStarts(int32 RequestsNum, const FString& IncomingName,
+	TSubclassOf<APawn> PawnClass, TArray<APlayerStart*>& OutPlayerStarts)
+{
+	OutPlayerStarts.Reset();
+
+	if (RequestsNum <= 0)
+	{
+		return;
+	}
+
+	RebuildIfDirty();
+	ResetOccupancyIfOutdated();
+
+	const APawn* PawnToFit = IsValid(PawnClass) ? PawnClass->GetDefaultObject<APawn>() : nullptr;
+
+	TArray<APlayerStart*> TaggedStarts;
+	if (!IncomingName.IsEmpty())
+	{
+		for (const TWeakObjectPtr<APlayerStart>& WeakPlayerStart : GetPlayerStartsWithTag(FName(*IncomingName)))
+		{
+			APlayerStart* PlayerStart = WeakPlayerStart.Get();
+			if (!IsValid(PlayerStart))
+			{
+				continue;
+			}
+
+			if (EvaluateOccupancy(PlayerStart, PawnToFit, false) == ETCU_PlayerStartOccupancy::Free)
+			{
+				TaggedStarts.Add(PlayerStart);
+			}
+			else
+			{
+				UE_LOG(LogGameMode, Log, TEXT("Skipping player start at [%s] because player can't fit in"),
+					*PlayerStart->GetActorLocation().ToString());
+			}
+		}
+	}
+
+	// Don't evaluate the rest of the player starts if the tagged ones are enough for everyone
+	APlayerStart* PIEStart = nullptr;
+	TArray<APlayerStart*> FreeStarts;
+	TArray<APlayerStart*> OccupiedStarts;
+	if (TaggedStarts.Num() < RequestsNum)
+	{
+		PIEStart = PIEPlayerStart.Get();
+
+		if (!IsValid(PIEStart))
+		{
+			for (const TWeakObjectPtr<APlayerStart>& WeakPlayerStart : PlayerStarts)
+			{
+				APlayerStart* PlayerStart = WeakPlayerStart.Get();
+				if (!IsValid(PlayerStart))
+				{
+					continue;
+				}
+
+				switch (EvaluateOccupancy(PlayerStart, PawnToFit, true))
+				{
+				case ETCU_PlayerStartOccupancy::Free:
+					FreeStarts.Add(PlayerStart);
+					break;
+				case ETCU_PlayerStartOccupancy::Occupied:
+					OccupiedStarts.Add(PlayerStart);
+					break;
+				default:
+					break;
+				}
+			}
+		}
+	}
+
+	AssignPlayerStarts(RequestsNum, PIEStart, MoveTemp(TaggedStarts), MoveTemp(FreeStarts),
+		MoveTemp(OccupiedStarts), OUT OutPlayerStarts);
+
+	for (APlayerStart* PlayerStart : OutPlayerStarts)
+	{
+		ClaimPlayerStart(PlayerStart);
+	}
+}
+
+void UTCU_PlayerStartSubsystem::FindPlayerStartsAsync(int32 RequestsNum, const FString& IncomingName,
+	TSubclassOf<APawn> PawnClass, FTCU_OnPlayerStartsFound OnFound)
+{
+	const APawn* PawnToFit = IsValid(PawnClass) ? PawnClass->GetDefaultObject<APawn>() : nullptr;
+	const auto* RootPrimitive = PawnToFit ? Cast<UPrimitiveComponent>(PawnToFit->GetRootComponent()) : nullptr;
+	if (RequestsNum <= 0 || !IsValid(RootPrimitive) || !RootPrimitive->IsQueryCollisionEnabled())
+	{
+		// Nothing to wait for
+		TArray<APlayerStart*> FoundPlayerStarts;
+		FindPlayerStarts(RequestsNum, IncomingName, PawnClass, OUT FoundPlayerStarts);
+		OnFound.ExecuteIfBound(FoundPlayerStarts);
+		return;
+	}
+
+	RebuildIfDirty();
+
+	const int32 RequestId = NextAsyncRequestId++;
+	FAsyncRequest& Request = AsyncRequests.Add(RequestId);
+	Request.RequestsNum = RequestsNum;
+	Request.PawnClass = PawnClass.Get();
+	Request.OnFound = MoveTemp(OnFound);
+
+	const FName IncomingPlayerStartTag = IncomingName.IsEmpty() ? NAME_None : FName(*IncomingName);
+	const bool bHasPIEPlayerStart = PIEPlayerStart.IsValid();
+	for (const TWeakObjectPtr<APlayerStart>& WeakPlayerStart : PlayerStarts)
+	{
+		const APlayerStart* PlayerStart = WeakPlayerStart.Get();
+		if (!IsValid(PlayerStart))
+		{
+			continue;
+		}
+
+		// Untagged player starts don't matter if the "Play from Here" one is going to be preferred anyway
+		const bool bTagged = !IncomingPlayerStartTag.IsNone() && PlayerStart->PlayerStartTag == IncomingPlayerStartTag;
+		if (bTagged || !bHasPIEPlayerStart)
+		{
+			FAsyncCandidate& Candidate = Request.Candidates.AddDefaulted_GetRef();
+			Candidate.PlayerStart = WeakPlayerStart;
+			Candidate.bTagged = bTagged;
+		}
+	}
+
+	if (Request.Candidates.IsEmpty())
+	{
+		CompleteAsyncRequest(RequestId);
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	const FCollisionShape CollisionShape = RootPrimitive->GetCollisionShape();
+	const ECollisionChannel CollisionChannel = RootPrimitive->GetCollisionObjectType();
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(TCU_PlayerStartOccupancy), false);
+	const FCollisionResponseParams ResponseParams(RootPrimitive->GetCollisionResponseToChannels());
+
+	Request.PendingChecksNum = Request.Candidates.Num();
+	for (int32 CandidateIndex = 0; CandidateIndex < Request.Candidates.Num(); CandidateIndex++)
+	{
+		const APlayerStart* PlayerStart = Request.Candidates[CandidateIndex].PlayerStart.Get();
+
+		FOverlapDelegate OverlapDelegate = FOverlapDelegate::CreateUObject(this,
+			&ThisClass::OnAsyncOverlapCompleted, RequestId, CandidateIndex);
+		World->AsyncOverlapByChannel(PlayerStart->GetActorLocation(), PlayerStart->GetActorQuat(),
+			CollisionChannel, CollisionShape, QueryParams, ResponseParams, &OverlapDelegate);
+	}
+}
+
+void UTCU_PlayerStartSubsystem::SpreadOverControllers(TConstArrayView<APlayerController*> Controllers,
+	TConstArrayView<APlayerStart*> FoundPlayerStarts, TArray<APlayerStart*>& OutPlayerStarts)
+{
+	OutPlayerStarts.Reset(Controllers.Num());
+
+	int32 PlayerStartIndex = 0;
+	for (const APlayerController* Controller : Controllers)
+	{
+		const bool bHasPlayerStart = IsValid(Controller) && FoundPlayerStarts.IsValidIndex(PlayerStartIndex);
+		OutPlayerStarts.Add(bHasPlayerStart ? FoundPlayerStarts[PlayerStartIndex++] : nullptr);
+	}
+}
+
+ETCU_PlayerStartOccupancy UTCU_PlayerStartSubsystem::GetOccupancy(APlayerStart* PlayerStart,
+	TSubclassOf<APawn> PawnClass)
+{
+	if (!IsValid(PlayerStart))
+	{
+		return ETCU_PlayerStartOccupancy::Blocked;
+	}
+
+	ResetOccupancyIfOutdated();
+
+	const APawn* PawnToFit = IsValid(PawnClass) ? PawnClass->GetDefaultObject<APawn>() : nullptr;
+	return EvaluateOccupancy(PlayerStart, PawnToFit, true);
+}
+
+TConstArrayView<TWeakObjectPtr<APlayerStart>> UTCU_PlayerStartSubsystem::GetPlayerStarts()
+{
+	RebuildIfDirty();
+	return PlayerStarts;
+}
+
+TConstArrayView<TWeakObjectPtr<APlayerStart>> UTCU_PlayerStartSubsystem::GetPlayerStartsWithTag(FName Tag)
+{
+	RebuildIfDirty();
+
+	const TArray<TWeakObjectPtr<APlayerStart>>* TaggedPlayerStarts = PlayerStartsByTag.Find(Tag);
+	return TaggedPlayerStarts ? *TaggedPlayerStarts : TConstArrayView<TWeakObjectPtr<APlayerStart>>();
+}
+
+APlayerStart* UTCU_PlayerStartSubsystem::GetPIEPlayerStart()
+{
+	RebuildIfDirty();
+	return PIEPlayerStart.Get();
+}
+
+void UTCU_PlayerStartSubsystem::ClaimPlayerStart(APlayerStart* PlayerStart)
+{
+	if (IsValid(PlayerStart))
+	{
+		ResetOccupancyIfOutdated();
+		ClaimedPlayerStarts.Add(PlayerStart);
+	}
+}
+
+void UTCU_PlayerStartSubsystem::AssignPlayerStarts(int32 RequestsNum, APlayerStart* PIEStart,
+	TArray<APlayerStart*> TaggedStarts, TArray<APlayerStart*> FreeStarts, TArray<APlayerStart*> OccupiedStarts,
+	TArray<APlayerStart*>& OutPlayerStarts)
+{
+	OutPlayerStarts.Reset(RequestsNum);
+
+	auto Shuffle = [](TArray<APlayerStart*>& Starts)
+	{
+		for (int32 Index = Starts.Num() - 1; Index > 0; Index--)
+		{
+			Starts.Swap(Index, FMath::RandRange(0, Index));
+		}
+	};
+
+	auto HandOut = [&OutPlayerStarts, RequestsNum](const TArray<APlayerStart*>& Starts)
+	{
+		for (APlayerStart* PlayerStart : Starts)
+		{
+			if (OutPlayerStarts.Num() >= RequestsNum)
+			{
+				break;
+			}
+
+			OutPlayerStarts.AddUnique(PlayerStart);
+		}
+	};
+
+	Shuffle(TaggedStarts);
+	HandOut(TaggedStarts);
+
+	if (IsValid(PIEStart))
+	{
+		// Always prefer the "Play from Here" PlayerStart, if we find one while in PIE mode
+		while (OutPlayerStarts.Num() < RequestsNum)
+		{
+			OutPlayerStarts.Add(PIEStart);
+		}
+
+		return;
+	}
+
+	Shuffle(FreeStarts);
+	HandOut(FreeStarts);
+
+	Shuffle(OccupiedStarts);
+	HandOut(OccupiedStarts);
+
+	// There are more requesters than player starts, some of them will have to share
+	const TArray<APlayerStart*>& SharedStarts = !FreeStarts.IsEmpty() ? FreeStarts : OccupiedStarts;
+	while (OutPlayerStarts.Num() < RequestsNum)
+	{
+		APlayerStart* PlayerStart = !SharedStarts.IsEmpty()
+			? SharedStarts[FMath::RandRange(0, SharedStarts.Num() - 1)]
+			: nullptr;
+
+		OutPlayerStarts.Add(PlayerStart);
+	}
+}
+
+void UTCU_PlayerStartSubsystem::RebuildIfDirty()
+{
+	if (!bDirty)
+	{
+		return;
+	}
+
+	bDirty = false;
+
+	PlayerStarts.Reset();
+	PlayerStartsByTag.Reset();
+	PIEPlayerStart.Reset();
+
+	for (TActorIterator<APlayerStart> It(GetWorld()); It; ++It)
+	{
+		APlayerStart* PlayerStart = *It;
+		if (!IsValid(PlayerStart))
+		{
+			continue;
+		}
+
+		if (!PIEPlayerStart.IsValid() && PlayerStart->IsA<APlayerStartPIE>())
+		{
+			PIEPlayerStart = PlayerStart;
+		}
+
+		PlayerStarts.Add(PlayerStart);
+
+		if (!PlayerStart->PlayerStartTag.IsNone())
+		{
+			PlayerStartsByTag.FindOrAdd(PlayerStart->PlayerStartTag).Add(PlayerStart);
+		}
+	}
+}
+
+void UTCU_PlayerStartSubsystem::ResetOccupancyIfOutdated()
+{
+	if (OccupancyFrame != GFrameCounter)
+	{
+		OccupancyFrame = GFrameCounter;
+		Occupancy.Reset();
+		ClaimedPlayerStarts.Reset();
+	}
+}
+
+ETCU_PlayerStartOccupancy UTCU_PlayerStartSubsystem::EvaluateOccupancy(const APlayerStart* PlayerStart,
+	const APawn* PawnToFit, bool bNeedTeleportCheck)
+{
+	UWorld* World = GetWorld();
+	const FVector ActorLocation = PlayerStart->GetActorLocation();
+	const FRotator ActorRotation = PlayerStart->GetActorRotation();
+
+	const FOccupancyKey Key(PlayerStart, PawnToFit ? PawnToFit->GetClass() : nullptr);
+	EOccupancyCheck* Check = Occupancy.Find(Key);
+	if (!Check)
+	{
+		const bool bCanFit = !World->EncroachingBlockingGeometry(PawnToFit, ActorLocation, ActorRotation);
+		Check = &Occupancy.Add(Key, bCanFit ? EOccupancyCheck::Free : EOccupancyCheck::Encroached);
+	}
+
+	// Someone has already been given this player start during this frame
+	if (*Check == EOccupancyCheck::Free && ClaimedPlayerStarts.Contains(PlayerStart))
+	{
+		*Check = EOccupancyCheck::Encroached;
+	}
+
+	if (*Check == EOccupancyCheck::Encroached && bNeedTeleportCheck)
+	{
+		FVector TeleportLocation = ActorLocation;
+		const bool bCanTeleport = World->FindTeleportSpot(PawnToFit, TeleportLocation, ActorRotation);
+		*Check = bCanTeleport ? EOccupancyCheck::Occupied : EOccupancyCheck::Blocked;
+	}
+
+	switch (*Check)
+	{
+	case EOccupancyCheck::Free:
+		return ETCU_PlayerStartOccupancy::Free;
+	case EOccupancyCheck::Occupied:
+		return ETCU_PlayerStartOccupancy::Occupied;
+	default:
+		return ETCU_PlayerStartOccupancy::Blocked;
+	}
+}
+
+void UTCU_PlayerStartSubsystem::OnAsyncOverlapCompleted(const FTraceHandle& TraceHandle,
+	FOverlapDatum& OverlapDatum, int32 RequestId, int32 CandidateIndex)
+{
+	FAsyncRequest* Request = AsyncRequests.Find(RequestId);
+	if (!Request)
+	{
+		return;
+	}
+
+	const bool bBlocked = OverlapDatum.OutOverlaps.ContainsByPredicate([](const FOverlapResult& Overlap)
+	{
+		return Overlap.bBlockingHit;
+	});
+	Request->Candidates[CandidateIndex].bFree = !bBlocked;
+
+	Request->PendingChecksNum--;
+	if (Request->PendingChecksNum == 0)
+	{
+		CompleteAsyncRequest(RequestId);
+	}
+}
+
+void UTCU_PlayerStartSubsystem::CompleteAsyncRequest(int32 RequestId)
+{
+	FAsyncRequest Request;
+	if (!AsyncRequests.RemoveAndCopyValue(RequestId, OUT Request))
+	{
+		return;
+	}
+
+	ResetOccupancyIfOutdated();
+
+	// Things might have changed while waiting for the results
+	RebuildIfDirty();
+
+	const UClass* PawnClass = Request.PawnClass.Get();
+	const APawn* PawnToFit = PawnClass ? PawnClass->GetDefaultObject<APawn>() : nullptr;
+	APlayerStart* PIEStart = PIEPlayerStart.Get();
+
+	TArray<APlayerStart*> TaggedStarts;
+	TArray<APlayerStart*> FreeStarts;
+	TArray<APlayerStart*> EncroachedStarts;
+	for (const FAsyncCandidate& Candidate : Request.Candidates)
+	{
+		APlayerStart* PlayerStart = Candidate.PlayerStart.Get();
+		if (!IsValid(PlayerStart))
+		{
+			continue;
+		}
+
+		const bool bFree = Candidate.bFree && !ClaimedPlayerStarts.Contains(PlayerStart);
+		if (Candidate.bTagged && bFree)
+		{
+			TaggedStarts.Add(PlayerStart);
+		}
+
+		if (bFree)
+		{
+			FreeStarts.Add(PlayerStart);
+		}
+		else
+		{
+			EncroachedStarts.Add(PlayerStart);
+		}
+	}
+
+	// Look for teleport spots only if the free player starts aren't enough for everyone
+	TArray<APlayerStart*> OccupiedStarts;
+	if (!IsValid(PIEStart) && FreeStarts.Num() < Request.RequestsNum)
+	{
+		for (APlayerStart* PlayerStart : EncroachedStarts)
+		{
+			if (EvaluateOccupancy(PlayerStart, PawnToFit, true) != ETCU_PlayerStartOccupancy::Blocked)
+			{
+				OccupiedStarts.Add(PlayerStart);
+			}
+		}
+	}
+
+	TArray<APlayerStart*> FoundPlayerStarts;
+	AssignPlayerStarts(Request.RequestsNum, PIEStart, MoveTemp(TaggedStarts), MoveTemp(FreeStarts),
+		MoveTemp(OccupiedStarts), OUT FoundPlayerStarts);
+
+	for (APlayerStart* PlayerStart : FoundPlayerStarts)
+	{
+		ClaimPlayerStart(PlayerStart);
+	}
+
+	Request.OnFound.ExecuteIfBound(FoundPlayerStarts);
+}
+
+void UTCU_PlayerStartSubsystem::OnActorSpawned(AActor* Actor)
+{
+	if (Actor->IsA<APlayerStart>())
+	{
+		bDirty = true;
+	}
+}
+
+void UTCU_PlayerStartSubsystem::OnActorDestroyed(AActor* Actor)
+{
+	if (Actor->IsA<APlayerStart>())
+	{
+		bDirty = true;
+	}
+}
+
+void UTCU_PlayerStartSubsystem::OnLevelChanged(ULevel* Level, UWorld* World)
+{
+	if (World == GetWorld())
+	{
+		bDirty = true;
+	}
+}
@@ -0,0 +1,330 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#include "System/TCU_SaveGameJournal.h"
+
+#include "Hash/CityHash.h"
+#include "HAL/FileManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "System/TCU_SaveGameProperties.h"
+#include "TCU_LogChannels.h"
+
+namespace TCU::SaveGameJournal
+{
+	/** "TCUJ" when read as bytes. */
+	static constexpr uint32 JournalMagic = 0x4A554354;
+	static constexpr int32 JournalVersion = 1;
+
+	using namespace SaveGameProperties;
+
+	static uint64 HashProperty(FProperty* Property, USaveGame* SaveGame, TArray<uint8>& OutValue)
+	{
+		OutValue.Reset();
+		FMemoryWriter Writer(OutValue, true);
+		SerializeProperty(Writer, Property, SaveGame);
+
+		return CityHash64(reinterpret_cast<const char*>(OutValue.GetData()), OutValue.Num());
+	}
+
+	static TArray<uint8> MakeJournalHeader(uint32 SlotDataCrc)
+	{
+		uint32 Magic = JournalMagic;
+		int32 Version = JournalVersion;
+
+		TArray<uint8> Header;
+		FMemoryWriter Writer(Header);
+		Writer << Magic << Version << SlotDataCrc;
+
+		return Header;
+	}
+
+	/** Whether the journal file still starts with the header it's been created with on top of the slot data. */
+	static bool HasJournalHeader(const FString& Path, uint32 SlotDataCrc)
+	{
+		const TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Path, FILEREAD_Silent));
+		if (!Reader)
+		{
+			return false;
+		}
+
+		uint32 Magic = 0;
+		int32 Version = 0;
+		uint32 JournalSlotDataCrc = 0;
+		*Reader << Magic << Version << JournalSlotDataCrc;
+
+		return !Reader->IsError() && Magic == JournalMagic && Version == JournalVersion &&
+			JournalSlotDataCrc == SlotDataCrc;
+	}
+}
+
+FTCU_SaveGameJournal::FTCU_SaveGameJournal(const FString& InSlotName, ETCU_SaveGameCompression InCompression)
+	: SlotName(InSlotName)
+	, Compression(InCompression)
+	, WriteFailedFlag(MakeShared<std::atomic<bool>>(false))
+{
+}
+
+TFuture<bool> FTCU_SaveGameJournal::Commit(USaveGame* SaveGame)
+{
+	using namespace TCU::SaveGameJournal;
+
+	check(IsInGameThread());
+
+	if (!IsValid(SaveGame))
+	{
+		return MakeFulfilledPromise<bool>(false).GetFuture();
+	}
+
+	if (ShouldCompact(SaveGame))
+	{
+		return Compact(SaveGame);
+	}
+
+	int32 EntriesNum = 0;
+	TArray<uint8> Record;
+	FMemoryWriter RecordWriter(Record);
+	RecordWriter << EntriesNum;
+
+	TArray<uint8> Value;
+	for (TFieldIterator<FProperty> Iterator(SaveGame->GetClass()); Iterator; ++Iterator)
+	{
+		FProperty* Property = *Iterator;
+		if (!ShouldSerialize(Property))
+		{
+			continue;
+		}
+
+		const uint64 Hash = HashProperty(Property, SaveGame, Value);
+		uint64& CommittedHash = CommittedHashes.FindOrAdd(Property->GetFName());
+		if (CommittedHash == Hash)
+		{
+			continue;
+		}
+
+		CommittedHash = Hash;
+		EntriesNum++;
+
+		FName Name = Property->GetFName();
+		FString Type = GetPropertyType(Property);
+		RecordWriter << Name << Type << Value;
+	}
+
+	if (EntriesNum == 0)
+	{
+		return MakeFulfilledPromise<bool>(true).GetFuture();
+	}
+
+	RecordWriter.Seek(0);
+	RecordWriter << EntriesNum;
+
+	RecordsNum++;
+	JournalSize += Record.Num();
+
+	return FTCU_SaveGameStorage::Enqueue(TEXT("TCU.CommitSaveGameJournal"),
+		[Path = GetJournalPath(SlotName), Record = MoveTemp(Record), SaveCompression = Compression,
+			BaseCrc = SlotDataCrc, WriteFailed = WriteFailedFlag]()
+		{
+			// The slot may have been replaced by a full save since the compaction, which drops or outdates the journal,
+			// so that whatever is appended to it would be ignored when loading
+			if (!HasJournalHeader(Path, BaseCrc))
+			{
+				UE_LOG(LogTCU, Warning, TEXT("Save game journal [%s] doesn't match its slot anymore"), *Path);
+				*WriteFailed = true;
+				return false;
+			}
+
+			TArray<uint8> EncodedRecord;
+			if (!FTCU_SaveGameStorage::Encode(Record, SaveCompression, EncodedRecord))
+			{
+				*WriteFailed = true;
+				return false;
+			}
+
+			int32 RecordSize = EncodedRecord.Num();
+			uint32 RecordCrc = FCrc::MemCrc32(EncodedRecord.GetData(), RecordSize);
+
+			const TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Path, FILEWRITE_Append));
+			if (!Writer)
+			{
+				*WriteFailed = true;
+				return false;
+			}
+
+			*Writer << RecordSize << RecordCrc;
+			Writer->Serialize(EncodedRecord.GetData(), RecordSize);
+
+			if (!Writer->Close())
+			{
+				UE_LOG(LogTCU, Warning, TEXT("Failed to append to save game journal [%s]"), *Path);
+				*WriteFailed = true;
+				return false;
+			}
+
+			return true;
+		});
+}
+
+TFuture<bool> FTCU_SaveGameJournal::Compact(USaveGame* SaveGame)
+{
+	using namespace TCU::SaveGameJournal;
+
+	check(IsInGameThread());
+
+	TArray<uint8> Data;
+	if (!IsValid(SaveGame) || !UGameplayStatics::SaveGameToMemory(SaveGame, Data))
+	{
+		return MakeFulfilledPromise<bool>(false).GetFuture();
+	}
+
+	CommittedHashes.Reset();
+	CommittedClass = SaveGame->GetClass();
+
+	TArray<uint8> Value;
+	for (TFieldIterator<FProperty> Iterator(SaveGame->GetClass()); Iterator; ++Iterator)
+	{
+		if (ShouldSerialize(*Iterator))
+		{
+			CommittedHashes.Add(Iterator->GetFName(), HashProperty(*Iterator, SaveGame, Value));
+		}
+	}
+
+	RecordsNum = 0;
+	JournalSize = 0;
+	SlotSize = Data.Num();
+	SlotDataCrc = FCrc::MemCrc32(Data.GetData(), Data.Num());
+	bCompacted = true;
+	*WriteFailedFlag = false;
+
+	return FTCU_SaveGameStorage::Enqueue(TEXT("TCU.CompactSaveGameJournal"),
+		[SlotPath = FTCU_SaveGameStorage::GetSlotPath(SlotName), JournalPath = GetJournalPath(SlotName),
+			Data = MoveTemp(Data), SaveCompression = Compression, BaseCrc = SlotDataCrc,
+			WriteFailed = WriteFailedFlag]()
+		{
+			// If the journal fails to be replaced, the old one doesn't match the new slot anymore, and is ignored
+			TArray<uint8> SlotData;
+			const bool bWritten = FTCU_SaveGameStorage::Encode(Data, SaveCompression, SlotData) &&
+				FTCU_SaveGameStorage::WriteFileAtomically(SlotPath, SlotData) &&
+				FTCU_SaveGameStorage::WriteFileAtomically(JournalPath, MakeJournalHeader(BaseCrc));
+
+			if (!bWritten)
+			{
+				UE_LOG(LogTCU, Warning, TEXT("Failed to compact save game journal into [%s]"), *SlotPath);
+				*WriteFailed = true;
+			}
+
+			return bWritten;
+		});
+}
+
+const FString& FTCU_SaveGameJournal::GetSlotName() const
+{
+	return SlotName;
+}
+
+FString FTCU_SaveGameJournal::GetJournalPath(const FString& SlotName)
+{
+	return FPaths::ChangeExtension(FTCU_SaveGameStorage::GetSlotPath(SlotName), TEXT("tcujournal"));
+}
+
+bool FTCU_SaveGameJournal::ReadJournal(const FString& Path, uint32 SlotDataCrc, TArray<TArray<uint8>>& OutRecords)
+{
+	using namespace TCU::SaveGameJournal;
+
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *Path, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	uint32 JournalSlotDataCrc = 0;
+
+	FMemoryReader Reader(Data);
+	Reader << Magic << Version << JournalSlotDataCrc;
+
+	if (Reader.IsError() || Magic != JournalMagic || Version != JournalVersion || JournalSlotDataCrc != SlotDataCrc)
+	{
+		return false;
+	}
+
+	while (!Reader.AtEnd())
+	{
+		int32 RecordSize = 0;
+		uint32 RecordCrc = 0;
+		Reader << RecordSize << RecordCrc;
+
+		if (Reader.IsError() || RecordSize < 0 || Reader.Tell() + RecordSize > Reader.TotalSize())
+		{
+			break;
+		}
+
+		const TConstArrayView<uint8> EncodedRecord(Data.GetData() + Reader.Tell(), RecordSize);
+		if (FCrc::MemCrc32(EncodedRecord.GetData(), RecordSize) != RecordCrc)
+		{
+			break;
+		}
+
+		TArray<uint8> Record;
+		if (!FTCU_SaveGameStorage::Decode(EncodedRecord, Record))
+		{
+			break;
+		}
+
+		OutRecords.Add(MoveTemp(Record));
+		Reader.Seek(Reader.Tell() + RecordSize);
+	}
+
+	return true;
+}
+
+bool FTCU_SaveGameJournal::ApplyRecord(USaveGame* SaveGame, TConstArrayView<uint8> Record)
+{
+	using namespace TCU::SaveGameJournal;
+
+	check(IsInGameThread());
+
+	FMemoryReaderView RecordReader(Record, true);
+
+	int32 EntriesNum = 0;
+	RecordReader << EntriesNum;
+
+	for (int32 Index = 0; Index < EntriesNum; Index++)
+	{
+		FName Name;
+		FString Type;
+		TArray<uint8> Value;
+		RecordReader << Name << Type << Value;
+
+		if (RecordReader.IsError())
+		{
+			return false;
+		}
+
+		// Properties that have been removed or changed their type since they've been saved are left as they are
+		FProperty* Property = FindFProperty<FProperty>(SaveGame->GetClass(), Name);
+		if (!Property || !ShouldSerialize(Property) || GetPropertyType(Property) != Type)
+		{
+			continue;
+		}
+
+		FMemoryReader ValueReader(Value, true);
+		SerializeProperty(ValueReader, Property, SaveGame);
+
+		if (ValueReader.IsError())
+		{
+			return false;
+		}
+	}
+
+	return !RecordReader.IsError();
+}
+
+bool FTCU_SaveGameJournal::ShouldCompact(const USaveGame* SaveGame) const
+{
+	return !bCompacted || *WriteFailedFlag || SaveGame->GetClass() != CommittedClass.Get() ||
+		RecordsNum >= MaxRecordsNum || JournalSize > SlotSize * MaxSizeRatio;
+}
@@ -0,0 +1,143 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#include "System/TCU_SaveGamePoolSubsystem.h"
+
+#include "Engine/Engine.h"
+#include "GameFramework/SaveGame.h"
+#include "System/TCU_SectionedSaveGame.h"
+#include "TCU_Stats.h"
+#include "UObject/UnrealType.h"
+
+UTCU_SaveGamePoolSubsystem* UTCU_SaveGamePoolSubsystem::Get()
+{
+	return GEngine ? GEngine->GetEngineSubsystem<ThisClass>() : nullptr;
+}
+
+USaveGame* UTCU_SaveGamePoolSubsystem::AcquireSaveGame(TSubclassOf<USaveGame> Class)
+{
+	if (ThisClass* Subsystem = Get())
+	{
+		return Subsystem->Acquire(Class);
+	}
+
+	return IsValid(Class) ? NewObject<USaveGame>(GetTransientPackage(), Class) : nullptr;
+}
+
+void UTCU_SaveGamePoolSubsystem::ReleaseSaveGame(USaveGame* SaveGame)
+{
+	if (ThisClass* Subsystem = Get())
+	{
+		Subsystem->Release(SaveGame);
+	}
+}
+
+void UTCU_SaveGamePoolSubsystem::Deinitialize()
+{
+	Trim();
+
+	Super::Deinitialize();
+}
+
+USaveGame* UTCU_SaveGamePoolSubsystem::Acquire(TSubclassOf<USaveGame> Class)
+{
+	check(IsInGameThread());
+
+	if (!IsValid(Class))
+	{
+		return nullptr;
+	}
+
+	FTCU_SaveGamePool& Pool = GetPool(Class);
+	if (!Pool.Objects.IsEmpty())
+	{
+		INC_DWORD_STAT(STAT_TCU_SaveGamePoolHits);
+		INC_DWORD_STAT(STAT_TCU_SaveGamePoolObjectsReused);
+		DEC_DWORD_STAT(STAT_TCU_SaveGamePoolPooledObjects);
+
+		return Pool.Objects.Pop();
+	}
+
+	INC_DWORD_STAT(STAT_TCU_SaveGamePoolMisses);
+	return NewObject<USaveGame>(GetTransientPackage(), Class);
+}
+
+void UTCU_SaveGamePoolSubsystem::Release(USaveGame* SaveGame)
+{
+	check(IsInGameThread());
+
+	if (!IsValid(SaveGame))
+	{
+		return;
+	}
+
+	FTCU_SaveGamePool& Pool = GetPool(SaveGame->GetClass());
+	if (!Pool.bCanBePooled || Pool.Objects.Num() >= MaxPooledObjectsPerClass)
+	{
+		return;
+	}
+
+	if (!ensureMsgf(!Pool.Objects.Contains(SaveGame), TEXT("Save game [%s] has been released twice"),
+		*SaveGame->GetName()))
+	{
+		return;
+	}
+
+	ResetToDefaults(SaveGame);
+	Pool.Objects.Add(SaveGame);
+
+	INC_DWORD_STAT(STAT_TCU_SaveGamePoolPooledObjects);
+}
+
+void UTCU_SaveGamePoolSubsystem::Trim()
+{
+	for (const TPair<TObjectPtr<UClass>, FTCU_SaveGamePool>& Pair : Pools)
+	{
+		DEC_DWORD_STAT_BY(STAT_TCU_SaveGamePoolPooledObjects, Pair.Value.Objects.Num());
+	}
+
+	Pools.Reset();
+}
+
+FTCU_SaveGamePool& UTCU_SaveGamePoolSubsystem::GetPool(UClass* Class)
+{
+	if (FTCU_SaveGamePool* Pool = Pools.Find(Class))
+	{
+		return *Pool;
+	}
+
+	FTCU_SaveGamePool& Pool = Pools.Add(Class);
+	Pool.bCanBePooled = CanBePooled(Class);
+
+	return Pool;
+}
+
+bool UTCU_SaveGamePoolSubsystem::CanBePooled(const UClass* Class)
+{
+	// Sectioned save games have native state that copying the class defaults doesn't reset
+	if (Class->HasAnyClassFlags(CLASS_Abstract) || Class->IsChildOf<UTCU_SectionedSaveGame>())
+	{
+		return false;
+	}
+
+	// Copying instanced references would make the objects share the subobjects of the class defaults
+	for (TFieldIterator<FProperty> Iterator(Class); Iterator; ++Iterator)
+	{
+		if (Iterator->HasAnyPropertyFlags(CPF_InstancedReference | CPF_ContainsInstancedReference))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void UTCU_SaveGamePoolSubsystem::ResetToDefaults(USaveGame* SaveGame)
+{
+	const UClass* Class = SaveGame->GetClass();
+	const USaveGame* Defaults = Class->GetDefaultObject<USaveGame>();
+
+	for (TFieldIterator<FProperty> Iterator(Class); Iterator; ++Iterator)
+	{
+		Iterator->CopyCompleteValue_InContainer(SaveGame, Defaults);
+	}
+}
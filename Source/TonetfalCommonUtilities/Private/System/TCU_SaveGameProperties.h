@@ -0,0 +1,34 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#pragma once
+
+#include "GameFramework/SaveGame.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "UObject/UnrealType.h"
+
+/** Serialization of individual properties of save games, for the save formats that store them separately. */
+namespace TCU::SaveGameProperties
+{
+	inline bool ShouldSerialize(const FProperty* Property)
+	{
+		// Same as what's skipped by persistent archives, which save games are serialized with
+		return !Property->HasAnyPropertyFlags(CPF_Transient | CPF_Deprecated);
+	}
+
+	/** Type of the property, including the types of its elements. */
+	inline FString GetPropertyType(const FProperty* Property)
+	{
+		FString ExtendedType;
+		const FString Type = Property->GetCPPType(&ExtendedType);
+
+		return Type + ExtendedType;
+	}
+
+	/** Serializes the value of the property the same way UGameplayStatics save games are. */
+	inline void SerializeProperty(FArchive& InnerArchive, FProperty* Property, USaveGame* SaveGame)
+	{
+		FObjectAndNameAsStringProxyArchive Archive(InnerArchive, InnerArchive.IsLoading());
+		FStructuredArchiveFromArchive Adapter(Archive);
+		Property->SerializeBinProperty(Adapter.GetSlot(), SaveGame);
+	}
+}
@@ -0,0 +1,277 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#include "System/TCU_SaveGameStorage.h"
+
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "System/TCU_SaveGameJournal.h"
+#include "Tasks/Pipe.h"
+#include "TCU_LogChannels.h"
+
+namespace TCU::SaveGameStorage
+{
+	/** "TCUS" when read as bytes. */
+	static constexpr uint32 SlotMagic = 0x53554354;
+	static constexpr int32 SlotVersion = 1;
+
+	/**
+	 * Largest data a slot can hold. The uncompressed size is read from the file before the data is unpacked, so this is
+	 * the most a corrupted slot can make Decode allocate.
+	 */
+	static constexpr int32 MaxUncompressedSize = 256 * 1024 * 1024;
+
+	static FName GetFormatName(ETCU_SaveGameCompression Compression)
+	{
+		switch (Compression)
+		{
+		case ETCU_SaveGameCompression::Zlib:
+			return NAME_Zlib;
+		case ETCU_SaveGameCompression::Oodle:
+			return NAME_Oodle;
+		default:
+			return NAME_None;
+		}
+	}
+
+	static FString GetTempPath(const FString& Path)
+	{
+		return Path + TEXT(".tmp");
+	}
+
+	/** Pipe all of the requests go through, so that they're carried out one after another. */
+	static UE::Tasks::FPipe& GetPipe()
+	{
+		static UE::Tasks::FPipe Pipe(TEXT("TCU.SaveGameStorage"));
+
+		// Don't let the game exit while a slot is being written
+		static const FDelegateHandle PreExitHandle = FCoreDelegates::OnPreExit.AddStatic(&FTCU_SaveGameStorage::Flush);
+
+		return Pipe;
+	}
+}
+
+TFuture<bool> FTCU_SaveGameStorage::SaveGameToSlotAsync(USaveGame* SaveGame, const FString& SlotName,
+	ETCU_SaveGameCompression Compression)
+{
+	check(IsInGameThread());
+
+	// Objects can be serialized on the game thread only, but that's the cheap part of it
+	TArray<uint8> Data;
+	if (!IsValid(SaveGame) || !UGameplayStatics::SaveGameToMemory(SaveGame, Data))
+	{
+		return MakeFulfilledPromise<bool>(false).GetFuture();
+	}
+
+	return Enqueue(TEXT("TCU.SaveGameToSlot"), [SlotName, Data = MoveTemp(Data), Compression]()
+	{
+		const FString Path = GetSlotPath(SlotName);
+
+		TArray<uint8> SlotData;
+		if (!Encode(Data, Compression, SlotData) || !WriteFileAtomically(Path, SlotData))
+		{
+			UE_LOG(LogTCU, Warning, TEXT("Failed to save game to [%s]"), *Path);
+			return false;
+		}
+
+		// The journal has been written on top of what's just been replaced
+		IFileManager::Get().Delete(*FTCU_SaveGameJournal::GetJournalPath(SlotName), false, false, true);
+		return true;
+	});
+}
+
+void FTCU_SaveGameStorage::LoadGameFromSlotAsync(const FString& SlotName,
+	TUniqueFunction<void(USaveGame*)>&& OnLoaded)
+{
+	Enqueue(TEXT("TCU.LoadGameFromSlot"), [SlotName, OnLoaded = MoveTemp(OnLoaded)]() mutable
+	{
+		TArray<uint8> Data;
+		TArray<TArray<uint8>> JournalRecords;
+
+		const bool bRead = ReadSlotFile(GetSlotPath(SlotName), Data);
+		if (bRead)
+		{
+			FTCU_SaveGameJournal::ReadJournal(FTCU_SaveGameJournal::GetJournalPath(SlotName),
+				FCrc::MemCrc32(Data.GetData(), Data.Num()), JournalRecords);
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [Data = MoveTemp(Data), JournalRecords = MoveTemp(JournalRecords),
+			bRead, OnLoaded = MoveTemp(OnLoaded)]()
+		{
+			USaveGame* SaveGame = bRead ? UGameplayStatics::LoadGameFromMemory(Data) : nullptr;
+			if (IsValid(SaveGame))
+			{
+				for (const TArray<uint8>& Record : JournalRecords)
+				{
+					if (!FTCU_SaveGameJournal::ApplyRecord(SaveGame, Record))
+					{
+						UE_LOG(LogTCU, Warning, TEXT("Save game journal is corrupted, the rest of it is dropped"));
+						break;
+					}
+				}
+			}
+
+			OnLoaded(SaveGame);
+		});
+
+		return bRead;
+	});
+}
+
+TFuture<bool> FTCU_SaveGameStorage::Enqueue(const TCHAR* DebugName, TUniqueFunction<bool()>&& Request)
+{
+	TPromise<bool> Promise;
+	TFuture<bool> Future = Promise.GetFuture();
+
+	TCU::SaveGameStorage::GetPipe().Launch(DebugName,
+		[Request = MoveTemp(Request), Promise = MoveTemp(Promise)]() mutable
+		{
+			Promise.SetValue(Request());
+		});
+
+	return Future;
+}
+
+void FTCU_SaveGameStorage::Flush()
+{
+	TCU::SaveGameStorage::GetPipe().WaitUntilEmpty();
+}
+
+FString FTCU_SaveGameStorage::GetSlotPath(const FString& SlotName)
+{
+	return FPaths::ProjectSavedDir() / TEXT("SaveGames") / SlotName + TEXT(".tcusav");
+}
+
+bool FTCU_SaveGameStorage::Encode(TConstArrayView<uint8> Data, ETCU_SaveGameCompression Compression,
+	TArray<uint8>& OutSlotData)
+{
+	using namespace TCU::SaveGameStorage;
+
+	uint32 Magic = SlotMagic;
+	int32 Version = SlotVersion;
+	uint8 CompressionValue = static_cast<uint8>(Compression);
+	int32 UncompressedSize = Data.Num();
+
+	if (UncompressedSize > MaxUncompressedSize)
+	{
+		UE_LOG(LogTCU, Warning, TEXT("Save game data of %d bytes exceeds the limit of %d bytes"), UncompressedSize,
+			MaxUncompressedSize);
+		return false;
+	}
+
+	OutSlotData.Reset();
+	FMemoryWriter Writer(OutSlotData);
+	Writer << Magic << Version << CompressionValue << UncompressedSize;
+
+	const int32 HeaderSize = OutSlotData.Num();
+	const FName FormatName = GetFormatName(Compression);
+	if (FormatName.IsNone())
+	{
+		OutSlotData.Append(Data.GetData(), Data.Num());
+		return true;
+	}
+
+	int32 CompressedSize = FCompression::CompressMemoryBound(FormatName, UncompressedSize);
+	OutSlotData.SetNumUninitialized(HeaderSize + CompressedSize);
+
+	if (!FCompression::CompressMemory(FormatName, OutSlotData.GetData() + HeaderSize, CompressedSize, Data.GetData(),
+		UncompressedSize))
+	{
+		return false;
+	}
+
+	OutSlotData.SetNum(HeaderSize + CompressedSize);
+	return true;
+}
+
+bool FTCU_SaveGameStorage::Decode(TConstArrayView<uint8> SlotData, TArray<uint8>& OutData)
+{
+	using namespace TCU::SaveGameStorage;
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	uint8 CompressionValue = 0;
+	int32 UncompressedSize = 0;
+
+	FMemoryReaderView Reader(SlotData);
+	Reader << Magic << Version << CompressionValue << UncompressedSize;
+
+	if (Reader.IsError() || Magic != SlotMagic || Version != SlotVersion || UncompressedSize < 0 ||
+		UncompressedSize > MaxUncompressedSize ||
+		CompressionValue > static_cast<uint8>(ETCU_SaveGameCompression::Oodle))
+	{
+		return false;
+	}
+
+	const TConstArrayView<uint8> Payload = SlotData.RightChop(Reader.Tell());
+	const FName FormatName = GetFormatName(static_cast<ETCU_SaveGameCompression>(CompressionValue));
+	if (FormatName.IsNone())
+	{
+		if (Payload.Num() != UncompressedSize)
+		{
+			return false;
+		}
+
+		OutData.Reset();
+		OutData.Append(Payload.GetData(), Payload.Num());
+		return true;
+	}
+
+	OutData.SetNumUninitialized(UncompressedSize);
+	return FCompression::UncompressMemory(FormatName, OutData.GetData(), UncompressedSize, Payload.GetData(),
+		Payload.Num());
+}
+
+bool FTCU_SaveGameStorage::WriteFileAtomically(const FString& Path, TConstArrayView<uint8> Data)
+{
+	IFileManager& FileManager = IFileManager::Get();
+
+	const FString TempPath = TCU::SaveGameStorage::GetTempPath(Path);
+	if (!FFileHelper::SaveArrayToFile(Data, *TempPath))
+	{
+		FileManager.Delete(*TempPath, false, false, true);
+		return false;
+	}
+
+	if (!FileManager.Move(*Path, *TempPath, true))
+	{
+		FileManager.Delete(*TempPath, false, false, true);
+		return false;
+	}
+
+	return true;
+}
+
+bool FTCU_SaveGameStorage::ReadSlotFile(const FString& Path, TArray<uint8>& OutData)
+{
+	IFileManager& FileManager = IFileManager::Get();
+
+	FString ReadPath = Path;
+	if (!FileManager.FileExists(*ReadPath))
+	{
+		ReadPath = TCU::SaveGameStorage::GetTempPath(Path);
+		if (!FileManager.FileExists(*ReadPath))
+		{
+			return false;
+		}
+	}
+
+	TArray<uint8> SlotData;
+	if (!FFileHelper::LoadFileToArray(SlotData, *ReadPath))
+	{
+		return false;
+	}
+
+	if (!Decode(SlotData, OutData))
+	{
+		UE_LOG(LogTCU, Warning, TEXT("Save game [%s] is corrupted"), *ReadPath);
+		return false;
+	}
+
+	return true;
+}
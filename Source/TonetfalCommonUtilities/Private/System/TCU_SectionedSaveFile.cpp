@@ -0,0 +1,205 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#include "System/TCU_SectionedSaveFile.h"
+
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace TCU::SectionedSaveFile
+{
+	/** "TCUM" when read as bytes. */
+	static constexpr uint32 FileMagic = 0x4D554354;
+	static constexpr int32 FileVersion = 1;
+
+	static void SerializeHeader(FArchive& Archive, FString& ClassPath, TArray<FName>& Names, TArray<FString>& Types,
+		TArray<int64>& Offsets, TArray<int64>& Sizes)
+	{
+		uint32 Magic = FileMagic;
+		int32 Version = FileVersion;
+		int32 SectionsNum = Names.Num();
+
+		Archive << Magic << Version;
+		if (Magic != FileMagic || Version != FileVersion)
+		{
+			Archive.SetError();
+			return;
+		}
+
+		Archive << ClassPath << SectionsNum;
+		if (Archive.IsError())
+		{
+			return;
+		}
+
+		if (Archive.IsLoading())
+		{
+			// Each entry takes more than a byte, so a corrupted count can't make the arrays larger than the file
+			if (SectionsNum < 0 || SectionsNum > Archive.TotalSize() - Archive.Tell())
+			{
+				Archive.SetError();
+				return;
+			}
+
+			Names.SetNum(SectionsNum);
+			Types.SetNum(SectionsNum);
+			Offsets.SetNum(SectionsNum);
+			Sizes.SetNum(SectionsNum);
+		}
+
+		for (int32 Index = 0; Index < SectionsNum; Index++)
+		{
+			Archive << Names[Index] << Types[Index] << Offsets[Index] << Sizes[Index];
+		}
+	}
+}
+
+FTCU_SectionedSaveFile::~FTCU_SectionedSaveFile()
+{
+	// The region has to be unmapped before the file is closed
+	MappedRegion.Reset();
+	MappedFile.Reset();
+}
+
+TSharedPtr<FTCU_SectionedSaveFile> FTCU_SectionedSaveFile::Open(const FString& Path)
+{
+	TSharedRef<FTCU_SectionedSaveFile> File = MakeShared<FTCU_SectionedSaveFile>();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	File->MappedFile.Reset(PlatformFile.OpenMapped(*Path));
+
+	// Array views are limited to 32 bit sizes, which is plenty for a save file
+	if (File->MappedFile && File->MappedFile->GetFileSize() > 0 && File->MappedFile->GetFileSize() <= MAX_int32)
+	{
+		File->MappedRegion.Reset(File->MappedFile->MapRegion(0, File->MappedFile->GetFileSize()));
+	}
+
+	if (File->MappedRegion)
+	{
+		File->Data = MakeArrayView(File->MappedRegion->GetMappedPtr(),
+			static_cast<int32>(File->MappedRegion->GetMappedSize()));
+	}
+	else
+	{
+		File->MappedFile.Reset();
+		if (!FFileHelper::LoadFileToArray(File->FileData, *Path, FILEREAD_Silent))
+		{
+			return nullptr;
+		}
+
+		File->Data = File->FileData;
+	}
+
+	if (!File->ReadSectionTable())
+	{
+		return nullptr;
+	}
+
+	return File;
+}
+
+bool FTCU_SectionedSaveFile::Encode(const FString& ClassPath, TConstArrayView<FSection> Sections,
+	ETCU_SaveGameCompression Compression, TArray<uint8>& OutFileData)
+{
+	FString HeaderClassPath = ClassPath;
+	TArray<FName> Names;
+	TArray<FString> Types;
+	TArray<int64> Offsets;
+	TArray<int64> Sizes;
+
+	TArray<TArray<uint8>> EncodedSections;
+	EncodedSections.SetNum(Sections.Num());
+
+	for (int32 Index = 0; Index < Sections.Num(); Index++)
+	{
+		if (!FTCU_SaveGameStorage::Encode(Sections[Index].Data, Compression, EncodedSections[Index]))
+		{
+			return false;
+		}
+
+		Names.Add(Sections[Index].Name);
+		Types.Add(Sections[Index].Type);
+		Sizes.Add(EncodedSections[Index].Num());
+	}
+
+	// The size of the header doesn't depend on the offsets, so it's known before they are
+	Offsets.SetNumZeroed(Sections.Num());
+
+	OutFileData.Reset();
+	FMemoryWriter Writer(OutFileData);
+	TCU::SectionedSaveFile::SerializeHeader(Writer, HeaderClassPath, Names, Types, Offsets, Sizes);
+
+	int64 Offset = OutFileData.Num();
+	for (int32 Index = 0; Index < Sections.Num(); Index++)
+	{
+		Offsets[Index] = Offset;
+		Offset += Sizes[Index];
+	}
+
+	Writer.Seek(0);
+	TCU::SectionedSaveFile::SerializeHeader(Writer, HeaderClassPath, Names, Types, Offsets, Sizes);
+
+	for (const TArray<uint8>& EncodedSection : EncodedSections)
+	{
+		OutFileData.Append(EncodedSection);
+	}
+
+	return !Writer.IsError();
+}
+
+const FString& FTCU_SectionedSaveFile::GetClassPath() const
+{
+	return ClassPath;
+}
+
+bool FTCU_SectionedSaveFile::HasSection(FName Name) const
+{
+	return Sections.Contains(Name);
+}
+
+int32 FTCU_SectionedSaveFile::GetSectionsNum() const
+{
+	return Sections.Num();
+}
+
+bool FTCU_SectionedSaveFile::ReadSection(FName Name, const FString& Type, TArray<uint8>& OutData) const
+{
+	const FSectionEntry* Section = Sections.Find(Name);
+	if (!Section || Section->Type != Type)
+	{
+		return false;
+	}
+
+	return FTCU_SaveGameStorage::Decode(Data.Slice(static_cast<int32>(Section->Offset),
+		static_cast<int32>(Section->Size)), OutData);
+}
+
+bool FTCU_SectionedSaveFile::ReadSectionTable()
+{
+	TArray<FName> Names;
+	TArray<FString> Types;
+	TArray<int64> Offsets;
+	TArray<int64> Sizes;
+
+	FMemoryReaderView Reader(Data);
+	TCU::SectionedSaveFile::SerializeHeader(Reader, ClassPath, Names, Types, Offsets, Sizes);
+
+	if (Reader.IsError())
+	{
+		return false;
+	}
+
+	for (int32 Index = 0; Index < Names.Num(); Index++)
+	{
+		if (Offsets[Index] < Reader.Tell() || Sizes[Index] < 0 || Sizes[Index] > Data.Num() - Offsets[Index])
+		{
+			return false;
+		}
+
+		Sections.Add(Names[Index], { Types[Index], Offsets[Index], Sizes[Index] });
+	}
+
+	return true;
+}
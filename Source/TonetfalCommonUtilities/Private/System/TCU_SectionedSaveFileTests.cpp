@@ -0,0 +1,109 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#include "System/TCU_SectionedSaveFile.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTCU_SectionedSaveFileRoundTripTest, "TCU.SaveGame.SectionedSaveFile.RoundTrip",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FTCU_SectionedSaveFileRoundTripTest::RunTest(const FString& Parameters)
+{
+	// More sections than the header takes bytes, as large save games have plenty of properties
+	static constexpr int32 SectionsNum = 150;
+	const FString ClassPath = TEXT("/Script/TonetfalCommonUtilities.TCU_SectionedSaveGame");
+
+	TArray<FTCU_SectionedSaveFile::FSection> Sections;
+	for (int32 Index = 0; Index < SectionsNum; Index++)
+	{
+		FTCU_SectionedSaveFile::FSection& Section = Sections.AddDefaulted_GetRef();
+		Section.Name = *FString::Printf(TEXT("Section_%d"), Index);
+		Section.Type = TEXT("Type");
+
+		// Some of the sections are empty
+		Section.Data.SetNumUninitialized(Index * 7 % 300);
+		for (int32 ByteIndex = 0; ByteIndex < Section.Data.Num(); ByteIndex++)
+		{
+			Section.Data[ByteIndex] = static_cast<uint8>(Index + ByteIndex);
+		}
+	}
+
+	const FString Path = FPaths::CreateTempFilename(*FPaths::AutomationTransientDir(), TEXT("TCU_"),
+		TEXT(".tcusections"));
+
+	for (const ETCU_SaveGameCompression Compression :
+		{ ETCU_SaveGameCompression::None, ETCU_SaveGameCompression::Zlib, ETCU_SaveGameCompression::Oodle })
+	{
+		TArray<uint8> FileData;
+		if (!TestTrue(TEXT("Encode"), FTCU_SectionedSaveFile::Encode(ClassPath, Sections, Compression, FileData)) ||
+			!TestTrue(TEXT("Write"), FFileHelper::SaveArrayToFile(FileData, *Path)))
+		{
+			break;
+		}
+
+		{
+			TSharedPtr<FTCU_SectionedSaveFile> File = FTCU_SectionedSaveFile::Open(Path);
+			if (!TestTrue(TEXT("Open"), File.IsValid()))
+			{
+				break;
+			}
+
+			TestEqual(TEXT("Class path"), File->GetClassPath(), ClassPath);
+			TestEqual(TEXT("Sections num"), File->GetSectionsNum(), SectionsNum);
+
+			for (const FTCU_SectionedSaveFile::FSection& Section : Sections)
+			{
+				TArray<uint8> Data;
+				if (TestTrue(TEXT("Read section"), File->ReadSection(Section.Name, Section.Type, Data)))
+				{
+					TestTrue(TEXT("Section data"), Data == Section.Data);
+				}
+			}
+
+			TArray<uint8> Data;
+			TestFalse(TEXT("Read section of another type"), File->ReadSection(Sections[0].Name, TEXT("Other"), Data));
+			TestFalse(TEXT("Read missing section"), File->ReadSection(TEXT("Missing"), TEXT("Type"), Data));
+		}
+
+		// Files that have been cut off must be rejected rather than read past their end
+		FileData.SetNum(FileData.Num() / 2);
+		if (TestTrue(TEXT("Write truncated"), FFileHelper::SaveArrayToFile(FileData, *Path)))
+		{
+			TestFalse(TEXT("Open truncated"), FTCU_SectionedSaveFile::Open(Path).IsValid());
+		}
+	}
+
+	// Offsets so large that adding the size to them overflows must be rejected too. Encode never writes those, so the
+	// header is written by hand
+	{
+		TArray<uint8> FileData;
+		FMemoryWriter Writer(FileData);
+
+		uint32 Magic = 0x4D554354;
+		int32 Version = 1;
+		FString HeaderClassPath = ClassPath;
+		int32 HeaderSectionsNum = 1;
+		FName Name = Sections[1].Name;
+		FString Type = Sections[1].Type;
+		int64 Offset = MAX_int64 - 4;
+		int64 Size = 16;
+		Writer << Magic << Version << HeaderClassPath << HeaderSectionsNum << Name << Type << Offset << Size;
+		FileData.AddZeroed(Size);
+
+		if (TestTrue(TEXT("Write huge offset"), FFileHelper::SaveArrayToFile(FileData, *Path)))
+		{
+			TestFalse(TEXT("Open huge offset"), FTCU_SectionedSaveFile::Open(Path).IsValid());
+		}
+	}
+
+	IFileManager::Get().Delete(*Path, false, true, true);
+	return true;
+}
+
+#endif
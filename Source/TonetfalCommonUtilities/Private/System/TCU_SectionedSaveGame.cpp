@@ -0,0 +1,145 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#include "System/TCU_SectionedSaveGame.h"
+
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "System/TCU_SaveGameProperties.h"
+#include "System/TCU_SectionedSaveFile.h"
+#include "TCU_LogChannels.h"
+
+UTCU_SectionedSaveGame* UTCU_SectionedSaveGame::LoadFromSlot(const FString& SlotName)
+{
+	check(IsInGameThread());
+
+	FTCU_SaveGameStorage::Flush();
+
+	const FString Path = GetSlotPath(SlotName);
+	TSharedPtr<FTCU_SectionedSaveFile> File = FTCU_SectionedSaveFile::Open(Path);
+	if (!File.IsValid())
+	{
+		return nullptr;
+	}
+
+	UClass* Class = FSoftClassPath(File->GetClassPath()).TryLoadClass<ThisClass>();
+	if (!IsValid(Class))
+	{
+		UE_LOG(LogTCU, Warning, TEXT("Save game [%s] is of unknown class [%s]"), *Path, *File->GetClassPath());
+		return nullptr;
+	}
+
+	auto* SaveGame = NewObject<ThisClass>(GetTransientPackage(), Class);
+	SaveGame->SourceFile = MoveTemp(File);
+
+	return SaveGame;
+}
+
+FString UTCU_SectionedSaveGame::GetSlotPath(const FString& SlotName)
+{
+	return FPaths::ChangeExtension(FTCU_SaveGameStorage::GetSlotPath(SlotName), TEXT("tcusections"));
+}
+
+TFuture<bool> UTCU_SectionedSaveGame::SaveToSlotAsync(const FString& SlotName, ETCU_SaveGameCompression Compression)
+{
+	using namespace TCU::SaveGameProperties;
+
+	check(IsInGameThread());
+
+	// Nothing can be left to be read from the file that is about to be replaced
+	LoadAllSections();
+
+	TArray<FTCU_SectionedSaveFile::FSection> Sections;
+	for (TFieldIterator<FProperty> Iterator(GetClass()); Iterator; ++Iterator)
+	{
+		FProperty* Property = *Iterator;
+		if (!ShouldSerialize(Property))
+		{
+			continue;
+		}
+
+		FTCU_SectionedSaveFile::FSection& Section = Sections.AddDefaulted_GetRef();
+		Section.Name = Property->GetFName();
+		Section.Type = GetPropertyType(Property);
+
+		FMemoryWriter Writer(Section.Data, true);
+		SerializeProperty(Writer, Property, this);
+	}
+
+	return FTCU_SaveGameStorage::Enqueue(TEXT("TCU.SaveSectionedGameToSlot"),
+		[Path = GetSlotPath(SlotName), ClassPath = GetClass()->GetPathName(), Sections = MoveTemp(Sections),
+			Compression]()
+		{
+			TArray<uint8> FileData;
+			if (!FTCU_SectionedSaveFile::Encode(ClassPath, Sections, Compression, FileData) ||
+				!FTCU_SaveGameStorage::WriteFileAtomically(Path, FileData))
+			{
+				UE_LOG(LogTCU, Warning, TEXT("Failed to save game to [%s]"), *Path);
+				return false;
+			}
+
+			return true;
+		});
+}
+
+bool UTCU_SectionedSaveGame::LoadSection(FName SectionName)
+{
+	FProperty* Property = FindFProperty<FProperty>(GetClass(), SectionName);
+	return Property && LoadSection(Property);
+}
+
+void UTCU_SectionedSaveGame::LoadAllSections()
+{
+	if (!SourceFile.IsValid())
+	{
+		return;
+	}
+
+	for (TFieldIterator<FProperty> Iterator(GetClass()); Iterator; ++Iterator)
+	{
+		LoadSection(*Iterator);
+	}
+
+	SourceFile.Reset();
+}
+
+bool UTCU_SectionedSaveGame::IsSectionLoaded(FName SectionName) const
+{
+	return !SourceFile.IsValid() || LoadedSections.Contains(SectionName);
+}
+
+bool UTCU_SectionedSaveGame::LoadSection(FProperty* Property)
+{
+	using namespace TCU::SaveGameProperties;
+
+	const FName SectionName = Property->GetFName();
+	if (!SourceFile.IsValid() || LoadedSections.Contains(SectionName))
+	{
+		return true;
+	}
+
+	// Sections that fail to be read aren't retried, as they'd fail over and over
+	LoadedSections.Add(SectionName);
+
+	if (!ShouldSerialize(Property))
+	{
+		return false;
+	}
+
+	TArray<uint8> Data;
+	if (!SourceFile->ReadSection(SectionName, GetPropertyType(Property), Data))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Data, true);
+	SerializeProperty(Reader, Property, this);
+
+	if (Reader.IsError())
+	{
+		UE_LOG(LogTCU, Warning, TEXT("Save game section [%s] is corrupted"), *SectionName.ToString());
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,93 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#include "System/TCU_ServerClockEstimator.h"
+
+void FTCU_ServerClockEstimator::AddSample(double LocalTime, double ServerTime, double RoundTripTime)
+{
+	const FSample Sample { ServerTime - LocalTime, FMath::Max(RoundTripTime, 0.0) };
+
+	if (Samples.Num() < FMath::Max(WindowSize, 1))
+	{
+		Samples.Add(Sample);
+	}
+	else
+	{
+		NextSampleIndex %= Samples.Num();
+		Samples[NextSampleIndex++] = Sample;
+	}
+
+	// The timestamp that has been delayed the least yields the highest offset, and the least it could have been
+	// delayed by is half of the lowest round trip time
+	double MaxRawOffset = Samples[0].RawOffset;
+	double MinRoundTripTime = Samples[0].RoundTripTime;
+	for (const FSample& Candidate : Samples)
+	{
+		MaxRawOffset = FMath::Max(MaxRawOffset, Candidate.RawOffset);
+		MinRoundTripTime = FMath::Min(MinRoundTripTime, Candidate.RoundTripTime);
+	}
+
+	TargetOffset = MaxRawOffset + MinRoundTripTime * 0.5;
+
+	if (!bHasOffset)
+	{
+		bHasOffset = true;
+		Offset = TargetOffset;
+		LastAdvanceTime = LocalTime;
+		LastServerTime = LocalTime + Offset;
+	}
+}
+
+void FTCU_ServerClockEstimator::Advance(double LocalTime)
+{
+	if (!bHasOffset)
+	{
+		return;
+	}
+
+	const double DeltaTime = FMath::Max(LocalTime - LastAdvanceTime, 0.0);
+	LastAdvanceTime = LocalTime;
+
+	const double Error = TargetOffset - Offset;
+	if (FMath::Abs(Error) > SnapThreshold)
+	{
+		Offset = TargetOffset;
+	}
+	else
+	{
+		const double MaxStep = MaxSlewRate * DeltaTime;
+		Offset += FMath::Clamp(Error, -MaxStep, MaxStep);
+	}
+
+	LastServerTime = FMath::Max(LastServerTime, LocalTime + Offset);
+}
+
+double FTCU_ServerClockEstimator::GetServerTime(double LocalTime) const
+{
+	return FMath::Max(LastServerTime, LocalTime + Offset);
+}
+
+bool FTCU_ServerClockEstimator::HasSamples() const
+{
+	return bHasOffset;
+}
+
+double FTCU_ServerClockEstimator::GetOffset() const
+{
+	return Offset;
+}
+
+double FTCU_ServerClockEstimator::GetTargetOffset() const
+{
+	return TargetOffset;
+}
+
+void FTCU_ServerClockEstimator::Reset()
+{
+	Samples.Reset();
+	NextSampleIndex = 0;
+	Offset = 0.0;
+	TargetOffset = 0.0;
+	LastAdvanceTime = 0.0;
+	LastServerTime = 0.0;
+	bHasOffset = false;
+}
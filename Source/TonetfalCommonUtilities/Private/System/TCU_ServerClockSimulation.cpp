@@ -0,0 +1,162 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#include "System/TCU_ServerClockEstimator.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace TCU::ServerClock::Simulation
+{
+	/** Offset between the simulated server and local clocks the estimate should converge to. */
+	static constexpr double TrueOffset = 1000.0;
+
+	static constexpr double FrameTime = 1.0 / 60.0;
+
+	/** How often the simulated server sends its time, like AGameStateBase::ServerWorldTimeSecondsUpdateFrequency. */
+	static constexpr double SendInterval = 0.1;
+
+	/** Time given to the estimators to settle before errors are accounted. */
+	static constexpr double WarmUpTime = 2.0;
+
+	struct FClockStats
+	{
+		void Add(double Time, double TrueTime)
+		{
+			const double Error = FMath::Abs(Time - TrueTime);
+			MaxError = FMath::Max(MaxError, Error);
+			ErrorSum += Error;
+			SamplesNum++;
+
+			if (SamplesNum > 1 && Time < PreviousTime)
+			{
+				BackwardStepsNum++;
+			}
+
+			PreviousTime = Time;
+		}
+
+		double GetMeanError() const
+		{
+			return SamplesNum > 0 ? ErrorSum / SamplesNum : 0.0;
+		}
+
+		double MaxError = 0.0;
+		double ErrorSum = 0.0;
+		double PreviousTime = 0.0;
+		int32 SamplesNum = 0;
+		int32 BackwardStepsNum = 0;
+	};
+
+	struct FPacket
+	{
+		double ArrivalTime = 0.0;
+		double ServerTime = 0.0;
+		double RoundTripTime = 0.0;
+	};
+
+	struct FProfile
+	{
+		const TCHAR* Name = nullptr;
+		double Latency = 0.0;
+		double Jitter = 0.0;
+
+		/** Errors the smoothed clock must stay within. They include up to a frame the samples wait to be processed. */
+		double MaxMeanError = 0.0;
+		double MaxError = 0.0;
+	};
+
+	/**
+	 * Runs the estimator against a simulated server whose timestamps are delayed by a base latency plus random jitter,
+	 * independently in each direction, and compares it with the raw correction AGameStateBase would apply.
+	 */
+	static void Run(const FProfile& Profile, double Duration, int32 Seed, FClockStats& OutRawStats,
+		FClockStats& OutSmoothedStats)
+	{
+		FRandomStream Random(Seed);
+		FTCU_ServerClockEstimator Estimator;
+
+		TArray<FPacket> InFlightPackets;
+		double NextSendTime = 0.0;
+		double RawOffset = 0.0;
+
+		for (double LocalTime = 0.0; LocalTime < Duration; LocalTime += FrameTime)
+		{
+			for (; NextSendTime <= LocalTime; NextSendTime += SendInterval)
+			{
+				const double Delay = Profile.Latency + Random.FRand() * Profile.Jitter;
+				const double ReturnDelay = Profile.Latency + Random.FRand() * Profile.Jitter;
+				InFlightPackets.Add({ NextSendTime + Delay, NextSendTime + TrueOffset, Delay + ReturnDelay });
+			}
+
+			for (int32 Index = 0; Index < InFlightPackets.Num();)
+			{
+				const FPacket& Packet = InFlightPackets[Index];
+				if (Packet.ArrivalTime > LocalTime)
+				{
+					Index++;
+					continue;
+				}
+
+				// Game state takes the server time as is at the moment it's received
+				RawOffset = Packet.ServerTime - LocalTime;
+				Estimator.AddSample(LocalTime, Packet.ServerTime, Packet.RoundTripTime);
+				InFlightPackets.RemoveAt(Index);
+			}
+
+			Estimator.Advance(LocalTime);
+
+			if (LocalTime >= WarmUpTime && Estimator.HasSamples())
+			{
+				const double TrueTime = LocalTime + TrueOffset;
+				OutRawStats.Add(LocalTime + RawOffset, TrueTime);
+				OutSmoothedStats.Add(Estimator.GetServerTime(LocalTime), TrueTime);
+			}
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTCU_ServerClockSimulationTest, "TCU.ServerClock.Simulation",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FTCU_ServerClockSimulationTest::RunTest(const FString& Parameters)
+{
+	using namespace TCU::ServerClock::Simulation;
+
+	static const FProfile Profiles[] =
+	{
+		{ TEXT("NoJitter"), 0.050, 0.000, 0.025, 0.025 },
+		{ TEXT("LowJitter"), 0.050, 0.030, 0.025, 0.030 },
+		{ TEXT("HighLatency"), 0.100, 0.080, 0.025, 0.050 },
+		{ TEXT("HighJitter"), 0.020, 0.150, 0.025, 0.080 },
+		{ TEXT("Congested"), 0.150, 0.250, 0.040, 0.120 },
+	};
+
+	static constexpr double Duration = 120.0;
+	static constexpr int32 SeedsNum = 4;
+
+	for (const FProfile& Profile : Profiles)
+	{
+		for (int32 Seed = 0; Seed < SeedsNum; Seed++)
+		{
+			FClockStats RawStats;
+			FClockStats SmoothedStats;
+			Run(Profile, Duration, Seed, RawStats, SmoothedStats);
+
+			const FString What = FString::Printf(TEXT("%s (seed %d)"), Profile.Name, Seed);
+			AddInfo(FString::Printf(TEXT("%s: raw mean error %.2f ms, max %.2f ms; smoothed mean error %.2f ms, ")
+				TEXT("max %.2f ms"), *What, RawStats.GetMeanError() * 1000.0, RawStats.MaxError * 1000.0,
+				SmoothedStats.GetMeanError() * 1000.0, SmoothedStats.MaxError * 1000.0));
+
+			TestTrue(What + TEXT(" has samples"), SmoothedStats.SamplesNum > 0);
+			TestTrue(What + TEXT(" mean error"), SmoothedStats.GetMeanError() <= Profile.MaxMeanError);
+			TestTrue(What + TEXT(" max error"), SmoothedStats.MaxError <= Profile.MaxError);
+			TestTrue(What + TEXT(" is more accurate than raw"), SmoothedStats.GetMeanError() < RawStats.GetMeanError());
+			TestEqual(What + TEXT(" backward steps"), SmoothedStats.BackwardStepsNum, 0);
+		}
+	}
+
+	return true;
+}
+
+#endif
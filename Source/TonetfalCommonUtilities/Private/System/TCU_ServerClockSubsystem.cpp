@@ -0,0 +1,84 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#include "System/TCU_ServerClockSubsystem.h"
+
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "System/TCU_WorldResolver.h"
+
+UTCU_ServerClockSubsystem* UTCU_ServerClockSubsystem::Get(const UObject* ContextObject)
+{
+	const UWorld* World = FTCU_WorldResolver::Resolve(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	return IsValid(World) ? World->GetSubsystem<ThisClass>() : nullptr;
+}
+
+void UTCU_ServerClockSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const UWorld* World = GetWorld();
+	if (World->GetNetMode() != NM_Client)
+	{
+		return;
+	}
+
+	SampleServerTime();
+	Estimator.Advance(World->GetTimeSeconds());
+}
+
+TStatId UTCU_ServerClockSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTCU_ServerClockSubsystem, STATGROUP_Tickables);
+}
+
+double UTCU_ServerClockSubsystem::GetServerTime() const
+{
+	const UWorld* World = GetWorld();
+	if (World->GetNetMode() == NM_Client && Estimator.HasSamples())
+	{
+		return Estimator.GetServerTime(World->GetTimeSeconds());
+	}
+
+	const AGameStateBase* GameState = World->GetGameState();
+	return IsValid(GameState) ? GameState->GetServerWorldTimeSeconds() : World->GetTimeSeconds();
+}
+
+const FTCU_ServerClockEstimator& UTCU_ServerClockSubsystem::GetEstimator() const
+{
+	return Estimator;
+}
+
+bool UTCU_ServerClockSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UTCU_ServerClockSubsystem::SampleServerTime()
+{
+	const UWorld* World = GetWorld();
+	const AGameStateBase* GameState = World->GetGameState();
+	if (!IsValid(GameState))
+	{
+		return;
+	}
+
+	// The game state stores the replicated server time as an offset from the local time at which it arrived, so a
+	// change of the offset means a new server timestamp has been received
+	const double LocalTime = World->GetTimeSeconds();
+	const double ServerTimeDelta = GameState->GetServerWorldTimeSeconds() - LocalTime;
+	if (bHasServerTimeDelta && FMath::IsNearlyEqual(ServerTimeDelta, LastServerTimeDelta, UE_KINDA_SMALL_NUMBER))
+	{
+		return;
+	}
+
+	LastServerTimeDelta = ServerTimeDelta;
+	bHasServerTimeDelta = true;
+
+	const APlayerController* PlayerController = World->GetFirstPlayerController();
+	const APlayerState* PlayerState = IsValid(PlayerController) ? PlayerController->PlayerState : nullptr;
+	const double RoundTripTime = IsValid(PlayerState) ? PlayerState->GetPingInMilliseconds() / 1000.0 : 0.0;
+
+	Estimator.AddSample(LocalTime, LocalTime + ServerTimeDelta, RoundTripTime);
+}
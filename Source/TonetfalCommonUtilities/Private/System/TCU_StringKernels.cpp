@@ -0,0 +1,447 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#include "System/TCU_StringKernels.h"
+
+#include "System/TCU_Library.h"
+
+#if PLATFORM_CPU_X86_FAMILY && defined(__AVX2__)
+	#include <immintrin.h>
+	#define TCU_STRING_KERNELS_AVX2 1
+#elif PLATFORM_CPU_X86_FAMILY
+	#include <emmintrin.h>
+	#define TCU_STRING_KERNELS_SSE2 1
+#elif PLATFORM_CPU_ARM_FAMILY && (defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64))
+	#include <arm_neon.h>
+	#define TCU_STRING_KERNELS_NEON 1
+#endif
+
+#ifndef TCU_STRING_KERNELS_AVX2
+	#define TCU_STRING_KERNELS_AVX2 0
+#endif
+#ifndef TCU_STRING_KERNELS_SSE2
+	#define TCU_STRING_KERNELS_SSE2 0
+#endif
+#ifndef TCU_STRING_KERNELS_NEON
+	#define TCU_STRING_KERNELS_NEON 0
+#endif
+
+#define TCU_STRING_KERNELS_SIMD (TCU_STRING_KERNELS_AVX2 || TCU_STRING_KERNELS_SSE2 || TCU_STRING_KERNELS_NEON)
+
+namespace TCU::StringKernels
+{
+#if TCU_STRING_KERNELS_AVX2
+	/** 16 UTF-16 code units. Movemask yields 2 bits per lane. */
+	struct FVector
+	{
+		static constexpr int32 Lanes = 16;
+		static constexpr int32 BitsPerLane = 2;
+
+		static FVector Load(const TCHAR* Data)
+		{
+			return { _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Data)) };
+		}
+
+		static FVector Splat(uint16 Value) { return { _mm256_set1_epi16(static_cast<short>(Value)) }; }
+		void Store(TCHAR* Data) const { _mm256_storeu_si256(reinterpret_cast<__m256i*>(Data), V); }
+
+		FVector Eq(uint16 Value) const { return { _mm256_cmpeq_epi16(V, Splat(Value).V) }; }
+		FVector InRange(uint16 Min, uint16 Max) const
+		{
+			// Unsigned Min <= V <= Max, as (V - Min) saturating-minus (Max - Min) == 0
+			const __m256i Shifted = _mm256_sub_epi16(V, Splat(Min).V);
+			const __m256i Overflow = _mm256_subs_epu16(Shifted, Splat(static_cast<uint16>(Max - Min)).V);
+			return { _mm256_cmpeq_epi16(Overflow, _mm256_setzero_si256()) };
+		}
+
+		FVector operator|(FVector Other) const { return { _mm256_or_si256(V, Other.V) }; }
+		FVector operator&(FVector Other) const { return { _mm256_and_si256(V, Other.V) }; }
+		FVector operator+(FVector Other) const { return { _mm256_add_epi16(V, Other.V) }; }
+		FVector operator-(FVector Other) const { return { _mm256_sub_epi16(V, Other.V) }; }
+		uint64 Mask() const { return static_cast<uint32>(_mm256_movemask_epi8(V)); }
+
+		__m256i V;
+	};
+#elif TCU_STRING_KERNELS_SSE2
+	/** 8 UTF-16 code units. Movemask yields 2 bits per lane. */
+	struct FVector
+	{
+		static constexpr int32 Lanes = 8;
+		static constexpr int32 BitsPerLane = 2;
+
+		static FVector Load(const TCHAR* Data) { return { _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data)) }; }
+		static FVector Splat(uint16 Value) { return { _mm_set1_epi16(static_cast<short>(Value)) }; }
+		void Store(TCHAR* Data) const { _mm_storeu_si128(reinterpret_cast<__m128i*>(Data), V); }
+
+		FVector Eq(uint16 Value) const { return { _mm_cmpeq_epi16(V, Splat(Value).V) }; }
+		FVector InRange(uint16 Min, uint16 Max) const
+		{
+			// Unsigned Min <= V <= Max, as (V - Min) saturating-minus (Max - Min) == 0
+			const __m128i Shifted = _mm_sub_epi16(V, Splat(Min).V);
+			const __m128i Overflow = _mm_subs_epu16(Shifted, Splat(static_cast<uint16>(Max - Min)).V);
+			return { _mm_cmpeq_epi16(Overflow, _mm_setzero_si128()) };
+		}
+
+		FVector operator|(FVector Other) const { return { _mm_or_si128(V, Other.V) }; }
+		FVector operator&(FVector Other) const { return { _mm_and_si128(V, Other.V) }; }
+		FVector operator+(FVector Other) const { return { _mm_add_epi16(V, Other.V) }; }
+		FVector operator-(FVector Other) const { return { _mm_sub_epi16(V, Other.V) }; }
+		uint64 Mask() const { return static_cast<uint32>(_mm_movemask_epi8(V)); }
+
+		__m128i V;
+	};
+#elif TCU_STRING_KERNELS_NEON
+	/** 8 UTF-16 code units. Lane masks are narrowed to bytes, so there are 8 bits per lane. */
+	struct FVector
+	{
+		static constexpr int32 Lanes = 8;
+		static constexpr int32 BitsPerLane = 8;
+
+		static FVector Load(const TCHAR* Data) { return { vld1q_u16(reinterpret_cast<const uint16_t*>(Data)) }; }
+		static FVector Splat(uint16 Value) { return { vdupq_n_u16(Value) }; }
+		void Store(TCHAR* Data) const { vst1q_u16(reinterpret_cast<uint16_t*>(Data), V); }
+
+		FVector Eq(uint16 Value) const { return { vceqq_u16(V, vdupq_n_u16(Value)) }; }
+		FVector InRange(uint16 Min, uint16 Max) const
+		{
+			return { vcleq_u16(vsubq_u16(V, vdupq_n_u16(Min)), vdupq_n_u16(static_cast<uint16>(Max - Min))) };
+		}
+
+		FVector operator|(FVector Other) const { return { vorrq_u16(V, Other.V) }; }
+		FVector operator&(FVector Other) const { return { vandq_u16(V, Other.V) }; }
+		FVector operator+(FVector Other) const { return { vaddq_u16(V, Other.V) }; }
+		FVector operator-(FVector Other) const { return { vsubq_u16(V, Other.V) }; }
+		uint64 Mask() const { return vget_lane_u64(vreinterpret_u64_u8(vmovn_u16(V)), 0); }
+
+		uint16x8_t V;
+	};
+#endif
+
+#if TCU_STRING_KERNELS_SIMD
+	/** Whether the vector path can be used. It's written for 2-byte characters, and doesn't handle Unicode spaces. */
+	static constexpr bool bVectorizeChars = sizeof(TCHAR) == 2;
+
+	static constexpr uint64 FullMask = FVector::Lanes * FVector::BitsPerLane == 64
+		? ~0ull
+		: (1ull << (FVector::Lanes * FVector::BitsPerLane)) - 1;
+
+	static int32 FirstLane(uint64 Mask)
+	{
+		return static_cast<int32>(FMath::CountTrailingZeros64(Mask)) / FVector::BitsPerLane;
+	}
+
+	static int32 LastLane(uint64 Mask)
+	{
+		return (63 - static_cast<int32>(FMath::CountLeadingZeros64(Mask))) / FVector::BitsPerLane;
+	}
+
+	static int32 LanesNum(uint64 Mask)
+	{
+		return static_cast<int32>(FPlatformMath::CountBits(Mask)) / FVector::BitsPerLane;
+	}
+
+	static bool CanVectorize(ETCU_WhitespaceSet Whitespace)
+	{
+		return bVectorizeChars && Whitespace != ETCU_WhitespaceSet::Unicode;
+	}
+
+	static FVector WhitespaceMask(FVector Vector, ETCU_WhitespaceSet Whitespace)
+	{
+		if (Whitespace == ETCU_WhitespaceSet::Default)
+		{
+			return Vector.Eq(' ') | Vector.Eq('\n') | Vector.Eq('\r');
+		}
+
+		return Vector.Eq(' ') | Vector.InRange('\t', '\r');
+	}
+#endif
+
+	const TCHAR* GetInstructionSetName()
+	{
+#if TCU_STRING_KERNELS_AVX2
+		return TEXT("AVX2");
+#elif TCU_STRING_KERNELS_SSE2
+		return TEXT("SSE2");
+#elif TCU_STRING_KERNELS_NEON
+		return TEXT("NEON");
+#else
+		return TEXT("Scalar");
+#endif
+	}
+
+	bool IsWhitespace(TCHAR Character, ETCU_WhitespaceSet Whitespace)
+	{
+		switch (Whitespace)
+		{
+		case ETCU_WhitespaceSet::Default:
+			return Character == ' ' || Character == '\n' || Character == '\r';
+		case ETCU_WhitespaceSet::Ascii:
+			return Character == ' ' || (Character >= '\t' && Character <= '\r');
+		case ETCU_WhitespaceSet::Unicode:
+			return FChar::IsWhitespace(Character);
+		default:
+			checkNoEntry();
+			return false;
+		}
+	}
+
+	int32 CountLeadingWhitespace(const TCHAR* Data, int32 Len, ETCU_WhitespaceSet Whitespace)
+	{
+#if TCU_STRING_KERNELS_SIMD
+		if (CanVectorize(Whitespace))
+		{
+			int32 Index = 0;
+			for (; Index + FVector::Lanes <= Len; Index += FVector::Lanes)
+			{
+				const uint64 NotSpaceMask = ~WhitespaceMask(FVector::Load(Data + Index), Whitespace).Mask() & FullMask;
+				if (NotSpaceMask != 0)
+				{
+					return Index + FirstLane(NotSpaceMask);
+				}
+			}
+
+			return Index + Scalar::CountLeadingWhitespace(Data + Index, Len - Index, Whitespace);
+		}
+#endif
+
+		return Scalar::CountLeadingWhitespace(Data, Len, Whitespace);
+	}
+
+	int32 CountTrailingWhitespace(const TCHAR* Data, int32 Len, ETCU_WhitespaceSet Whitespace)
+	{
+#if TCU_STRING_KERNELS_SIMD
+		if (CanVectorize(Whitespace))
+		{
+			int32 End = Len;
+			for (; End >= FVector::Lanes; End -= FVector::Lanes)
+			{
+				const int32 Start = End - FVector::Lanes;
+				const uint64 NotSpaceMask = ~WhitespaceMask(FVector::Load(Data + Start), Whitespace).Mask() & FullMask;
+				if (NotSpaceMask != 0)
+				{
+					return Len - (Start + LastLane(NotSpaceMask) + 1);
+				}
+			}
+
+			return Len - End + Scalar::CountTrailingWhitespace(Data, End, Whitespace);
+		}
+#endif
+
+		return Scalar::CountTrailingWhitespace(Data, Len, Whitespace);
+	}
+
+	int32 CountWhitespace(const TCHAR* Data, int32 Len, ETCU_WhitespaceSet Whitespace)
+	{
+#if TCU_STRING_KERNELS_SIMD
+		if (CanVectorize(Whitespace))
+		{
+			int32 Count = 0;
+			int32 Index = 0;
+			for (; Index + FVector::Lanes <= Len; Index += FVector::Lanes)
+			{
+				Count += LanesNum(WhitespaceMask(FVector::Load(Data + Index), Whitespace).Mask());
+			}
+
+			return Count + Scalar::CountWhitespace(Data + Index, Len - Index, Whitespace);
+		}
+#endif
+
+		return Scalar::CountWhitespace(Data, Len, Whitespace);
+	}
+
+	void ClassifyWhitespace(const TCHAR* Data, int32 Len, ETCU_WhitespaceSet Whitespace, bool* OutIsWhitespace)
+	{
+#if TCU_STRING_KERNELS_SIMD
+		if (CanVectorize(Whitespace))
+		{
+			int32 Index = 0;
+			for (; Index + FVector::Lanes <= Len; Index += FVector::Lanes)
+			{
+				const uint64 SpaceMask = WhitespaceMask(FVector::Load(Data + Index), Whitespace).Mask();
+				for (int32 Lane = 0; Lane < FVector::Lanes; Lane++)
+				{
+					OutIsWhitespace[Index + Lane] = (SpaceMask >> (Lane * FVector::BitsPerLane) & 1) != 0;
+				}
+			}
+
+			Scalar::ClassifyWhitespace(Data + Index, Len - Index, Whitespace, OutIsWhitespace + Index);
+			return;
+		}
+#endif
+
+		Scalar::ClassifyWhitespace(Data, Len, Whitespace, OutIsWhitespace);
+	}
+
+	void ToLowerAscii(TCHAR* Data, int32 Len)
+	{
+#if TCU_STRING_KERNELS_SIMD
+		if constexpr (bVectorizeChars)
+		{
+			const FVector CaseBit = FVector::Splat('a' - 'A');
+
+			int32 Index = 0;
+			for (; Index + FVector::Lanes <= Len; Index += FVector::Lanes)
+			{
+				const FVector Vector = FVector::Load(Data + Index);
+				(Vector + (Vector.InRange('A', 'Z') & CaseBit)).Store(Data + Index);
+			}
+
+			Scalar::ToLowerAscii(Data + Index, Len - Index);
+			return;
+		}
+#endif
+
+		Scalar::ToLowerAscii(Data, Len);
+	}
+
+	void ToUpperAscii(TCHAR* Data, int32 Len)
+	{
+#if TCU_STRING_KERNELS_SIMD
+		if constexpr (bVectorizeChars)
+		{
+			const FVector CaseBit = FVector::Splat('a' - 'A');
+
+			int32 Index = 0;
+			for (; Index + FVector::Lanes <= Len; Index += FVector::Lanes)
+			{
+				const FVector Vector = FVector::Load(Data + Index);
+				(Vector - (Vector.InRange('a', 'z') & CaseBit)).Store(Data + Index);
+			}
+
+			Scalar::ToUpperAscii(Data + Index, Len - Index);
+			return;
+		}
+#endif
+
+		Scalar::ToUpperAscii(Data, Len);
+	}
+
+	int32 CountCharsInSet(const TCHAR* Data, int32 Len, TConstArrayView<TCHAR> Set)
+	{
+		if (Set.IsEmpty())
+		{
+			return 0;
+		}
+
+#if TCU_STRING_KERNELS_SIMD
+		if constexpr (bVectorizeChars)
+		{
+			int32 Count = 0;
+			int32 Index = 0;
+			for (; Index + FVector::Lanes <= Len; Index += FVector::Lanes)
+			{
+				const FVector Vector = FVector::Load(Data + Index);
+
+				FVector Matches = Vector.Eq(Set[0]);
+				for (int32 SetIndex = 1; SetIndex < Set.Num(); SetIndex++)
+				{
+					Matches = Matches | Vector.Eq(Set[SetIndex]);
+				}
+
+				Count += LanesNum(Matches.Mask());
+			}
+
+			return Count + Scalar::CountCharsInSet(Data + Index, Len - Index, Set);
+		}
+#endif
+
+		return Scalar::CountCharsInSet(Data, Len, Set);
+	}
+
+	void FillRepeated(TCHAR* Dest, const TCHAR* Pattern, int32 PatternLen, int32 Count)
+	{
+		const int64 TotalLen = static_cast<int64>(PatternLen) * Count;
+		if (TotalLen <= 0)
+		{
+			return;
+		}
+
+		// Copy the pattern once, then keep doubling what's already written. Every copy reads from the front of the
+		// destination and writes right after the filled part, so the two never overlap
+		FMemory::Memcpy(Dest, Pattern, PatternLen * sizeof(TCHAR));
+
+		int64 FilledLen = PatternLen;
+		while (FilledLen < TotalLen)
+		{
+			const int64 ChunkLen = FMath::Min(FilledLen, TotalLen - FilledLen);
+			FMemory::Memcpy(Dest + FilledLen, Dest, ChunkLen * sizeof(TCHAR));
+			FilledLen += ChunkLen;
+		}
+	}
+
+	namespace Scalar
+	{
+		int32 CountLeadingWhitespace(const TCHAR* Data, int32 Len, ETCU_WhitespaceSet Whitespace)
+		{
+			int32 Index = 0;
+			while (Index < Len && IsWhitespace(Data[Index], Whitespace))
+			{
+				Index++;
+			}
+
+			return Index;
+		}
+
+		int32 CountTrailingWhitespace(const TCHAR* Data, int32 Len, ETCU_WhitespaceSet Whitespace)
+		{
+			int32 End = Len;
+			while (End > 0 && IsWhitespace(Data[End - 1], Whitespace))
+			{
+				End--;
+			}
+
+			return Len - End;
+		}
+
+		int32 CountWhitespace(const TCHAR* Data, int32 Len, ETCU_WhitespaceSet Whitespace)
+		{
+			int32 Count = 0;
+			for (int32 Index = 0; Index < Len; Index++)
+			{
+				Count += IsWhitespace(Data[Index], Whitespace) ? 1 : 0;
+			}
+
+			return Count;
+		}
+
+		void ClassifyWhitespace(const TCHAR* Data, int32 Len, ETCU_WhitespaceSet Whitespace, bool* OutIsWhitespace)
+		{
+			for (int32 Index = 0; Index < Len; Index++)
+			{
+				OutIsWhitespace[Index] = IsWhitespace(Data[Index], Whitespace);
+			}
+		}
+
+		void ToLowerAscii(TCHAR* Data, int32 Len)
+		{
+			for (int32 Index = 0; Index < Len; Index++)
+			{
+				if (Data[Index] >= 'A' && Data[Index] <= 'Z')
+				{
+					Data[Index] += 'a' - 'A';
+				}
+			}
+		}
+
+		void ToUpperAscii(TCHAR* Data, int32 Len)
+		{
+			for (int32 Index = 0; Index < Len; Index++)
+			{
+				if (Data[Index] >= 'a' && Data[Index] <= 'z')
+				{
+					Data[Index] -= 'a' - 'A';
+				}
+			}
+		}
+
+		int32 CountCharsInSet(const TCHAR* Data, int32 Len, TConstArrayView<TCHAR> Set)
+		{
+			int32 Count = 0;
+			for (int32 Index = 0; Index < Len; Index++)
+			{
+				Count += Set.Contains(Data[Index]) ? 1 : 0;
+			}
+
+			return Count;
+		}
+	}
+}
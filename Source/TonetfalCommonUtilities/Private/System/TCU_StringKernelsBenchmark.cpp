@@ -0,0 +1,159 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#include "System/TCU_Library.h"
+#include "System/TCU_StringKernels.h"
+#include "TCU_LogChannels.h"
+
+#if !UE_BUILD_SHIPPING
+
+namespace TCU::StringKernels::Benchmark
+{
+	/** Roughly how many bytes each kernel processes per string size, so small sizes get enough iterations. */
+	static constexpr int64 BytesPerMeasurement = 64ll * 1024 * 1024;
+
+	static constexpr int32 MinBytes = 16;
+	static constexpr int32 MaxBytes = 1024 * 1024;
+
+	/** Accumulates results so that the compiler can't throw the measured calls away. Logged once done. */
+	static int64 Sink = 0;
+
+	template<typename FunctionType>
+	static double Measure(int32 Bytes, FunctionType&& Function)
+	{
+		const int32 IterationsNum = static_cast<int32>(FMath::Clamp<int64>(BytesPerMeasurement / Bytes, 1, 1 << 20));
+
+		// Warm up caches and branch predictors
+		Function();
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		for (int32 Iteration = 0; Iteration < IterationsNum; Iteration++)
+		{
+			Function();
+		}
+
+		const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+		return Seconds > 0.0 ? static_cast<double>(Bytes) * IterationsNum / Seconds / (1024.0 * 1024.0) : 0.0;
+	}
+
+	static void Report(const TCHAR* Name, int32 Bytes, double ScalarSpeed, double KernelSpeed)
+	{
+		UE_LOG(LogTCU, Display, TEXT("%-24s %8d B %12.1f MB/s %12.1f MB/s %8.2fx"), Name, Bytes, ScalarSpeed,
+			KernelSpeed, ScalarSpeed > 0.0 ? KernelSpeed / ScalarSpeed : 0.0);
+	}
+
+	/** Mix of words, punctuation and spaces of both cases, so that every kernel has something to do. */
+	static FString MakeText(int32 Len)
+	{
+		static const TCHAR Source[] = TEXT("The Quick, brown fox; Jumps over\tthe LAZY dog.\r\n");
+		const int32 SourceLen = UE_ARRAY_COUNT(Source) - 1;
+
+		FString Text;
+		Text.Reserve(Len);
+		for (int32 Index = 0; Index < Len; Index++)
+		{
+			Text.AppendChar(Source[Index % SourceLen]);
+		}
+
+		return Text;
+	}
+
+	/** Whitespace with a single letter at the end, the worst case for trimming from the front. */
+	static FString MakeLeadingSpaces(int32 Len)
+	{
+		FString Text = FString::ChrN(Len - 1, TEXT(' '));
+		Text.AppendChar(TEXT('x'));
+		return Text;
+	}
+
+	/** Whitespace with a single letter at the front, the worst case for trimming from the back. */
+	static FString MakeTrailingSpaces(int32 Len)
+	{
+		FString Text = TEXT("x");
+		Text += FString::ChrN(Len - 1, TEXT(' '));
+		return Text;
+	}
+
+	/** Repeat as it was before it used FillRepeated, to measure against. */
+	static FString RepeatByAppending(const FString& String, int32 Count)
+	{
+		FString ReturnValue;
+		for (int32 i = 0; i < Count; ++i)
+		{
+			ReturnValue += String;
+		}
+
+		return ReturnValue;
+	}
+
+	static void Run(const TArray<FString>& Args)
+	{
+		const ETCU_WhitespaceSet Whitespace = ETCU_WhitespaceSet::Ascii;
+		const TCHAR SetChars[] = { TEXT(','), TEXT('.'), TEXT(';'), TEXT(':') };
+		const TConstArrayView<TCHAR> Set = SetChars;
+
+		UE_LOG(LogTCU, Display, TEXT("String kernels benchmark, compiled for %s, %d-byte TCHAR"),
+			GetInstructionSetName(), static_cast<int32>(sizeof(TCHAR)));
+		UE_LOG(LogTCU, Display, TEXT("%-24s %10s %17s %17s %9s"), TEXT("Kernel"), TEXT("Size"), TEXT("Scalar"),
+			TEXT("Kernel"), TEXT("Speedup"));
+
+		for (int32 Bytes = MinBytes; Bytes <= MaxBytes; Bytes *= 2)
+		{
+			const int32 Len = Bytes / static_cast<int32>(sizeof(TCHAR));
+
+			const FString LeadingSpaces = MakeLeadingSpaces(Len);
+			Report(TEXT("CountLeadingWhitespace"), Bytes,
+				Measure(Bytes, [&] { Sink += Scalar::CountLeadingWhitespace(*LeadingSpaces, Len, Whitespace); }),
+				Measure(Bytes, [&] { Sink += CountLeadingWhitespace(*LeadingSpaces, Len, Whitespace); }));
+
+			const FString TrailingSpaces = MakeTrailingSpaces(Len);
+			Report(TEXT("CountTrailingWhitespace"), Bytes,
+				Measure(Bytes, [&] { Sink += Scalar::CountTrailingWhitespace(*TrailingSpaces, Len, Whitespace); }),
+				Measure(Bytes, [&] { Sink += CountTrailingWhitespace(*TrailingSpaces, Len, Whitespace); }));
+
+			const FString Text = MakeText(Len);
+			Report(TEXT("CountWhitespace"), Bytes,
+				Measure(Bytes, [&] { Sink += Scalar::CountWhitespace(*Text, Len, Whitespace); }),
+				Measure(Bytes, [&] { Sink += CountWhitespace(*Text, Len, Whitespace); }));
+
+			TArray<bool> SpaceFlags;
+			SpaceFlags.SetNumUninitialized(Len);
+			Report(TEXT("ClassifyWhitespace"), Bytes,
+				Measure(Bytes, [&] { Scalar::ClassifyWhitespace(*Text, Len, Whitespace, SpaceFlags.GetData()); }),
+				Measure(Bytes, [&] { ClassifyWhitespace(*Text, Len, Whitespace, SpaceFlags.GetData()); }));
+
+			// Folding back and forth keeps the input the same between iterations
+			FString FoldedText = Text;
+			TCHAR* FoldedData = FoldedText.GetCharArray().GetData();
+			Report(TEXT("ToLowerAscii/ToUpperAscii"), Bytes,
+				Measure(Bytes, [&]
+				{
+					Scalar::ToLowerAscii(FoldedData, Len);
+					Scalar::ToUpperAscii(FoldedData, Len);
+				}),
+				Measure(Bytes, [&]
+				{
+					ToLowerAscii(FoldedData, Len);
+					ToUpperAscii(FoldedData, Len);
+				}));
+
+			Report(TEXT("CountCharsInSet"), Bytes,
+				Measure(Bytes, [&] { Sink += Scalar::CountCharsInSet(*Text, Len, Set); }),
+				Measure(Bytes, [&] { Sink += CountCharsInSet(*Text, Len, Set); }));
+
+			const FString Pattern = TEXT("=-");
+			const int32 Count = FMath::Max(Len / Pattern.Len(), 1);
+			Report(TEXT("Repeat"), Bytes,
+				Measure(Bytes, [&] { Sink += RepeatByAppending(Pattern, Count).Len(); }),
+				Measure(Bytes, [&] { Sink += UTCU_Library::Repeat(Pattern, Count).Len(); }));
+		}
+
+		UE_LOG(LogTCU, Verbose, TEXT("Benchmark checksum: %lld"), Sink);
+	}
+}
+
+static FAutoConsoleCommand GBenchmarkStringKernelsCommand(
+	TEXT("TCU.BenchmarkStringKernels"),
+	TEXT("Measures throughput of the string kernels against their scalar versions, on strings from 16 B to 1 MB."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&TCU::StringKernels::Benchmark::Run));
+
+#endif
@@ -0,0 +1,153 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#include "Misc/AutomationTest.h"
+#include "System/TCU_Library.h"
+#include "System/TCU_StringKernels.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace TCU::StringKernels::Tests
+{
+	/** Characters on both sides of the ranges the kernels compare against, including Unicode whitespace. */
+	static constexpr TCHAR Chars[] =
+	{
+		TEXT(' '), TEXT('\t'), TEXT('\n'), TEXT('\v'), TEXT('\f'), TEXT('\r'), TEXT('\x1F'), TEXT('!'),
+		TEXT('@'), TEXT('A'), TEXT('Z'), TEXT('['), TEXT('`'), TEXT('a'), TEXT('z'), TEXT('{'),
+		TEXT(','), TEXT('.'), TEXT(';'), TEXT(':'), TEXT('0'), TEXT('\x7F'),
+		static_cast<TCHAR>(0x00A0), static_cast<TCHAR>(0x00C0), static_cast<TCHAR>(0x2003), static_cast<TCHAR>(0x3000),
+	};
+
+	/**
+	 * Fills the buffer with random characters. Mostly whitespace buffers have a single other character at a random
+	 * position, if any, so that leading and trailing whitespace runs cover whole vectors and end within them.
+	 */
+	static void FillBuffer(TArray<TCHAR>& Buffer, int32 Len, FRandomStream& Random, bool bMostlyWhitespace)
+	{
+		Buffer.SetNumUninitialized(Len);
+		for (TCHAR& Character : Buffer)
+		{
+			Character = bMostlyWhitespace
+				? TEXT(' ')
+				: Chars[Random.RandHelper(static_cast<int32>(UE_ARRAY_COUNT(Chars)))];
+		}
+
+		if (bMostlyWhitespace && Len > 0)
+		{
+			// One position past the end leaves the buffer made of whitespace only
+			const int32 Index = Random.RandHelper(Len + 1);
+			if (Index < Len)
+			{
+				Buffer[Index] = TEXT('x');
+			}
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTCU_StringKernelsMatchScalarTest, "TCU.StringKernels.MatchScalar",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FTCU_StringKernelsMatchScalarTest::RunTest(const FString& Parameters)
+{
+	using namespace TCU::StringKernels;
+
+	// Every short length around the vector widths, and the sizes the benchmark measures, starting at every alignment
+	// within 32 bytes, so that vector loops and tails are both covered
+	static constexpr int32 MaxShortLen = 130;
+	static constexpr int32 OffsetsNum = 32 / static_cast<int32>(sizeof(TCHAR));
+
+	TArray<int32> Lens;
+	for (int32 Len = 0; Len <= MaxShortLen; Len++)
+	{
+		Lens.Add(Len);
+	}
+
+	for (int32 Bytes = 16; Bytes <= 1024 * 1024; Bytes *= 2)
+	{
+		Lens.AddUnique(Bytes / static_cast<int32>(sizeof(TCHAR)));
+	}
+
+	const TCHAR SetChars[] = { TEXT(','), TEXT('.'), TEXT(';'), TEXT(':') };
+	const TConstArrayView<TCHAR> Set = SetChars;
+
+	FRandomStream Random(0);
+	int32 MismatchesNum = 0;
+
+	const auto Check = [this, &MismatchesNum](bool bEqual, const TCHAR* Name, int32 Len, int32 Offset)
+	{
+		if (!bEqual)
+		{
+			AddError(FString::Printf(TEXT("%s differs from its scalar version for %d characters at offset %d"), Name,
+				Len, Offset));
+			MismatchesNum++;
+		}
+	};
+
+	TArray<TCHAR> Buffer;
+	TArray<TCHAR> KernelBuffer;
+	TArray<TCHAR> ScalarBuffer;
+	TArray<bool> KernelFlags;
+	TArray<bool> ScalarFlags;
+
+	// A broken kernel would otherwise report the same mismatch for nearly every case
+	for (int32 LenIndex = 0; LenIndex < Lens.Num() && MismatchesNum < 32; LenIndex++)
+	{
+		const int32 Len = Lens[LenIndex];
+		for (int32 Offset = 0; Offset < OffsetsNum; Offset++)
+		{
+			for (const bool bMostlyWhitespace : { false, true })
+			{
+				Tests::FillBuffer(Buffer, Offset + Len, Random, bMostlyWhitespace);
+				const TCHAR* Data = Buffer.GetData() + Offset;
+
+				for (const ETCU_WhitespaceSet Whitespace :
+					{ ETCU_WhitespaceSet::Default, ETCU_WhitespaceSet::Ascii, ETCU_WhitespaceSet::Unicode })
+				{
+					Check(CountLeadingWhitespace(Data, Len, Whitespace) ==
+						Scalar::CountLeadingWhitespace(Data, Len, Whitespace), TEXT("CountLeadingWhitespace"), Len,
+						Offset);
+					Check(CountTrailingWhitespace(Data, Len, Whitespace) ==
+						Scalar::CountTrailingWhitespace(Data, Len, Whitespace), TEXT("CountTrailingWhitespace"), Len,
+						Offset);
+					Check(CountWhitespace(Data, Len, Whitespace) == Scalar::CountWhitespace(Data, Len, Whitespace),
+						TEXT("CountWhitespace"), Len, Offset);
+
+					KernelFlags.SetNumUninitialized(Len);
+					ScalarFlags.SetNumUninitialized(Len);
+					ClassifyWhitespace(Data, Len, Whitespace, KernelFlags.GetData());
+					Scalar::ClassifyWhitespace(Data, Len, Whitespace, ScalarFlags.GetData());
+					Check(KernelFlags == ScalarFlags, TEXT("ClassifyWhitespace"), Len, Offset);
+				}
+
+				Check(CountCharsInSet(Data, Len, Set) == Scalar::CountCharsInSet(Data, Len, Set),
+					TEXT("CountCharsInSet"), Len, Offset);
+
+				KernelBuffer = Buffer;
+				ScalarBuffer = Buffer;
+				ToLowerAscii(KernelBuffer.GetData() + Offset, Len);
+				Scalar::ToLowerAscii(ScalarBuffer.GetData() + Offset, Len);
+				Check(KernelBuffer == ScalarBuffer, TEXT("ToLowerAscii"), Len, Offset);
+
+				KernelBuffer = Buffer;
+				ScalarBuffer = Buffer;
+				ToUpperAscii(KernelBuffer.GetData() + Offset, Len);
+				Scalar::ToUpperAscii(ScalarBuffer.GetData() + Offset, Len);
+				Check(KernelBuffer == ScalarBuffer, TEXT("ToUpperAscii"), Len, Offset);
+			}
+		}
+	}
+
+	for (const FString& Pattern : { FString(TEXT("x")), FString(TEXT("=-")), FString(TEXT("aBcDe")) })
+	{
+		FString Expected;
+		for (int32 Count = 0; Count <= MaxShortLen; Count++)
+		{
+			Check(UTCU_Library::Repeat(Pattern, Count).Equals(Expected, ESearchCase::CaseSensitive), TEXT("Repeat"),
+				Pattern.Len() * Count, 0);
+			Expected += Pattern;
+		}
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,103 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#include "System/TCU_WorldResolver.h"
+
+#include "TCU_Stats.h"
+#include "UObject/ObjectKey.h"
+
+namespace TCU::WorldResolver
+{
+	struct FCacheEntry
+	{
+		FObjectKey Object;
+		TWeakObjectPtr<UWorld> World;
+	};
+
+	/** Must be a power of two. */
+	static constexpr uint32 CacheSize = 1024;
+
+	static FCacheEntry Cache[CacheSize];
+
+	static FCacheEntry& GetEntry(const UObject* ContextObject)
+	{
+		return Cache[PointerHash(ContextObject) & (CacheSize - 1)];
+	}
+
+	static void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+	{
+		for (FCacheEntry& Entry : Cache)
+		{
+			if (Entry.World == World)
+			{
+				Entry = FCacheEntry();
+			}
+		}
+	}
+
+	static void RegisterCleanupOnce()
+	{
+		static const FDelegateHandle WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddStatic(&OnWorldCleanup);
+	}
+}
+
+UWorld* FTCU_WorldResolver::Resolve(const UObject* ContextObject, EGetWorldErrorMode ErrorMode)
+{
+	using namespace TCU::WorldResolver;
+
+	if (!ContextObject || !IsInGameThread())
+	{
+		return GEngine->GetWorldFromContextObject(ContextObject, ErrorMode);
+	}
+
+	FCacheEntry& Entry = GetEntry(ContextObject);
+	const FObjectKey ObjectKey(ContextObject);
+	if (Entry.Object == ObjectKey)
+	{
+		if (UWorld* World = Entry.World.Get())
+		{
+			INC_DWORD_STAT(STAT_TCU_WorldResolverHits);
+			return World;
+		}
+	}
+
+	INC_DWORD_STAT(STAT_TCU_WorldResolverMisses);
+
+	UWorld* World = GEngine->GetWorldFromContextObject(ContextObject, ErrorMode);
+	if (World)
+	{
+		RegisterCleanupOnce();
+
+		Entry.Object = ObjectKey;
+		Entry.World = World;
+	}
+
+	return World;
+}
+
+void FTCU_WorldResolver::Forget(const UObject* ContextObject)
+{
+	using namespace TCU::WorldResolver;
+
+	if (!ContextObject || !IsInGameThread())
+	{
+		return;
+	}
+
+	FCacheEntry& Entry = GetEntry(ContextObject);
+	if (Entry.Object == FObjectKey(ContextObject))
+	{
+		Entry = FCacheEntry();
+	}
+}
+
+void FTCU_WorldResolver::Reset()
+{
+	using namespace TCU::WorldResolver;
+
+	check(IsInGameThread());
+
+	for (FCacheEntry& Entry : Cache)
+	{
+		Entry = FCacheEntry();
+	}
+}
@@ -0,0 +1,7 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#pragma once
+
+#include "Logging/LogMacros.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogTCU, Log, All);
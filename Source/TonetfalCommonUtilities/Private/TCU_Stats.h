@@ -0,0 +1,15 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#pragma once
+
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("Tonetfal's Common Utilities"), STATGROUP_TCU, STATCAT_Advanced);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("World Resolver Hits"), STAT_TCU_WorldResolverHits, STATGROUP_TCU, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("World Resolver Misses"), STAT_TCU_WorldResolverMisses, STATGROUP_TCU, );
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Save Game Pool Hits"), STAT_TCU_SaveGamePoolHits, STATGROUP_TCU, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Save Game Pool Misses"), STAT_TCU_SaveGamePoolMisses, STATGROUP_TCU, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pooled Save Games"), STAT_TCU_SaveGamePoolPooledObjects, STATGROUP_TCU, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Save Games Reused"), STAT_TCU_SaveGamePoolObjectsReused, STATGROUP_TCU, );
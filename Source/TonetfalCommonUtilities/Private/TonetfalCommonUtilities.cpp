@@ -1,3 +1,15 @@
 // Author: Antonio Sidenko (Tonetfal), November 2024
 
+#include "TCU_LogChannels.h"
+#include "TCU_Stats.h"
+
+DEFINE_LOG_CATEGORY(LogTCU);
+
+DEFINE_STAT(STAT_TCU_WorldResolverHits);
+DEFINE_STAT(STAT_TCU_WorldResolverMisses);
+DEFINE_STAT(STAT_TCU_SaveGamePoolHits);
+DEFINE_STAT(STAT_TCU_SaveGamePoolMisses);
+DEFINE_STAT(STAT_TCU_SaveGamePoolPooledObjects);
+DEFINE_STAT(STAT_TCU_SaveGamePoolObjectsReused);
+
 IMPLEMENT_MODULE(FDefaultModuleImpl, TonetfalCommonUtilities)
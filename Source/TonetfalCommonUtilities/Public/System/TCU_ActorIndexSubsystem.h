@@ -0,0 +1,105 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+
+#include "TCU_ActorIndexSubsystem.generated.h"
+
+/**
+ * Per-world index of live actors used by the actor queries of UTCU_Library.
+ *
+ * Buckets are built lazily: the first query for a given key scans the world once, and from that moment the bucket
+ * is kept up to date through actor spawn/destroy and level streaming notifications.
+ *
+ * Tag queries of UTCU_Library only use the index when UTCU_Settings::bUseActorTagIndex is enabled, as the index doesn't
+ * see tags added to AActor::Tags directly.
+ */
+UCLASS()
+class TONETFALCOMMONUTILITIES_API UTCU_ActorIndexSubsystem
+	: public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+	struct FActorBucket
+	{
+		TArray<TWeakObjectPtr<AActor>> Actors;
+
+		/** Levels whose actors have already been added to the bucket. */
+		TSet<TObjectKey<ULevel>> IndexedLevels;
+	};
+
+	using FTagBucketKey = TPair<FName, TObjectKey<UClass>>;
+
+public:
+	/** Returns the index of the world the context object belongs to, or null if the world doesn't have one. */
+	static UTCU_ActorIndexSubsystem* Get(const UObject* ContextObject);
+
+	//~UWorldSubsystem Interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of UWorldSubsystem Interface
+
+	/** Returns any live actor whose class implements the given interface. */
+	AActor* GetActorWithInterface(TSubclassOf<UInterface> Interface);
+
+	/** Gathers all the live actors whose class implements the given interface. */
+	void GetActorsWithInterface(TSubclassOf<UInterface> Interface, TArray<AActor*>& OutActors);
+
+	/** Returns any live actor of the given class that has the given tag. */
+	AActor* GetActorWithTag(TSubclassOf<AActor> ActorClass, FName Tag);
+
+	/** Gathers all the live actors of the given class that have the given tag. */
+	void GetActorsWithTag(TSubclassOf<AActor> ActorClass, FName Tag, TArray<AActor*>& OutActors);
+
+	/** Gathers all the live actors of the given class that have every one of the given tags. */
+	void GetActorsWithAllTags(TSubclassOf<AActor> ActorClass, TConstArrayView<FName> Tags,
+		TArray<AActor*>& OutActors);
+
+	/** Gathers all the live actors of the given class that have at least one of the given tags. */
+	void GetActorsWithAnyTag(TSubclassOf<AActor> ActorClass, TConstArrayView<FName> Tags,
+		TArray<AActor*>& OutActors);
+
+	/**
+	 * Re-indexes the tags of the given actor. AActor::Tags doesn't notify anyone when it's modified, so every direct
+	 * edit of it that adds tags must be reported with this, otherwise the actor won't be found by the tag queries.
+	 * UTCU_Library::AddActorTag reports them on its own. Removed tags don't have to be reported, as actors that no
+	 * longer have them are dropped lazily by the queries.
+	 */
+	void NotifyActorTagsChanged(AActor* Actor);
+
+protected:
+	//~UWorldSubsystem Interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~End of UWorldSubsystem Interface
+
+private:
+	FActorBucket& FindOrBuildInterfaceBucket(UClass* Interface);
+	FActorBucket& FindOrBuildTagBucket(UClass* ActorClass, FName Tag);
+	template<typename PredicateType>
+	void BuildBucket(FActorBucket& Bucket, PredicateType Predicate);
+
+	static AActor* GetFirstValidActor(FActorBucket& Bucket);
+	static AActor* GetFirstValidTaggedActor(FActorBucket& Bucket, FName Tag);
+	static bool ImplementsInterface(const AActor* Actor, const TObjectKey<UClass>& Interface);
+	static bool MatchesTagKey(const AActor* Actor, const FTagBucketKey& Key);
+
+	void AddActor(AActor* Actor);
+	void RemoveActor(AActor* Actor);
+
+	void OnActorSpawned(AActor* Actor);
+	void OnActorDestroyed(AActor* Actor);
+	void OnLevelAddedToWorld(ULevel* Level, UWorld* World);
+	void OnLevelRemovedFromWorld(ULevel* Level, UWorld* World);
+
+private:
+	TMap<TObjectKey<UClass>, FActorBucket> InterfaceBuckets;
+	TMap<FTagBucketKey, FActorBucket> TagBuckets;
+
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle ActorDestroyedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+};
@@ -0,0 +1,48 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#pragma once
+
+#include "Kismet/BlueprintAsyncActionBase.h"
+
+#include "TCU_AsyncAction_FindPlayerStarts.generated.h"
+
+class APlayerController;
+class APlayerStart;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FTCU_FindPlayerStartsSignature,
+	const TArray<APlayerStart*>&, PlayerStarts);
+
+/**
+ * Latent version of FindPlayerStarts. Occupancy of the player starts is checked using async overlap queries instead of
+ * blocking the game thread.
+ */
+UCLASS()
+class TONETFALCOMMONUTILITIES_API UTCU_AsyncAction_FindPlayerStarts
+	: public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category="Game|Misc", DisplayName="Find Player Starts (Async)",
+		meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject"))
+	static UTCU_AsyncAction_FindPlayerStarts* FindPlayerStartsAsync(const UObject* WorldContextObject,
+		const TArray<APlayerController*>& Controllers, const FString& IncomingName, TSubclassOf<APawn> PawnClass);
+
+	//~UBlueprintAsyncActionBase Interface
+	virtual void Activate() override;
+	//~End of UBlueprintAsyncActionBase Interface
+
+private:
+	void OnPlayerStartsFound(const TArray<APlayerStart*>& PlayerStarts);
+
+public:
+	/** Called once player starts have been picked. They're in the same order as the controllers. */
+	UPROPERTY(BlueprintAssignable)
+	FTCU_FindPlayerStartsSignature OnCompleted;
+
+private:
+	TWeakObjectPtr<const UObject> WeakContextObject;
+	TArray<TWeakObjectPtr<APlayerController>> WeakControllers;
+	FString PlayerStartName;
+	TSubclassOf<APawn> PawnToSpawnClass;
+};
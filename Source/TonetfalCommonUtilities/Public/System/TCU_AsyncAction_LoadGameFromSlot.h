@@ -0,0 +1,43 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#pragma once
+
+#include "Kismet/BlueprintAsyncActionBase.h"
+
+#include "TCU_AsyncAction_LoadGameFromSlot.generated.h"
+
+class USaveGame;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FTCU_LoadGameFromSlotSignature, USaveGame*, SaveGame);
+
+/**
+ * Latent version of LoadGameFromSlotAsync. The slot is read and decompressed on a worker thread, while the object is
+ * created on the game thread.
+ */
+UCLASS()
+class TONETFALCOMMONUTILITIES_API UTCU_AsyncAction_LoadGameFromSlot
+	: public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category="Game|SaveGame", DisplayName="Load Game from Slot (Compressed, Async)",
+		meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject"))
+	static UTCU_AsyncAction_LoadGameFromSlot* LoadGameFromSlotAsync(const UObject* WorldContextObject,
+		const FString& SlotName);
+
+	//~UBlueprintAsyncActionBase Interface
+	virtual void Activate() override;
+	//~End of UBlueprintAsyncActionBase Interface
+
+private:
+	void OnLoaded(USaveGame* SaveGame);
+
+public:
+	/** Called once the slot has been loaded. The save game is null if the slot couldn't be loaded. */
+	UPROPERTY(BlueprintAssignable)
+	FTCU_LoadGameFromSlotSignature OnCompleted;
+
+private:
+	FString LoadSlotName;
+};
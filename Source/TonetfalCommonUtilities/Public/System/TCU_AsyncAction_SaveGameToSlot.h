@@ -0,0 +1,47 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#pragma once
+
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "System/TCU_SaveGameStorage.h"
+
+#include "TCU_AsyncAction_SaveGameToSlot.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FTCU_SaveGameToSlotSignature, bool, bSuccess);
+
+/**
+ * Latent version of SaveGameToSlotAsync. The object is serialized right away, while compression and writing happen on
+ * a worker thread.
+ */
+UCLASS()
+class TONETFALCOMMONUTILITIES_API UTCU_AsyncAction_SaveGameToSlot
+	: public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category="Game|SaveGame", DisplayName="Save Game to Slot (Compressed, Async)",
+		meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject"))
+	static UTCU_AsyncAction_SaveGameToSlot* SaveGameToSlotAsync(const UObject* WorldContextObject,
+		USaveGame* SaveGame, const FString& SlotName,
+		ETCU_SaveGameCompression Compression = ETCU_SaveGameCompression::Oodle);
+
+	//~UBlueprintAsyncActionBase Interface
+	virtual void Activate() override;
+	//~End of UBlueprintAsyncActionBase Interface
+
+private:
+	void OnSaved(bool bSuccess);
+
+public:
+	/** Called on the game thread once the slot has been written, or failed to be. */
+	UPROPERTY(BlueprintAssignable)
+	FTCU_SaveGameToSlotSignature OnCompleted;
+
+private:
+	UPROPERTY()
+	TObjectPtr<USaveGame> SaveGameObject;
+
+	FString SaveSlotName;
+	ETCU_SaveGameCompression SaveCompression = ETCU_SaveGameCompression::Oodle;
+};
@@ -0,0 +1,76 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Class.h"
+
+#include <type_traits>
+
+/**
+ * Class checks and casts that are resolved at compile time whenever the static type allows it. Objects that are
+ * statically known to be of the class aren't checked at all. Objects checked against final classes have their class
+ * compared first, and only have the class hierarchy walked if it differs, as final native classes can still be derived
+ * from by blueprints.
+ */
+namespace TCU::Private
+{
+	template<typename UserClass, typename ObjectType>
+	bool IsOfClass(const ObjectType* Object)
+	{
+		if constexpr (std::is_base_of_v<UserClass, ObjectType>)
+		{
+			return true;
+		}
+		else if constexpr (std::is_final_v<UserClass>)
+		{
+			return Object->GetClass() == UserClass::StaticClass() || Object->template IsA<UserClass>();
+		}
+		else
+		{
+			return Object->template IsA<UserClass>();
+		}
+	}
+
+	template<typename UserClass, typename ObjectType>
+	UserClass* CastToClass(ObjectType* Object)
+	{
+		return Object && IsOfClass<UserClass>(Object) ? static_cast<UserClass*>(Object) : nullptr;
+	}
+
+	/**
+	 * Calls the callable on each object of the class. The class hierarchy is only walked when the class of the object
+	 * differs from the one of the previous object, as arrays tend to hold runs of objects of the same class.
+	 */
+	template<typename CallableType>
+	void ForEachOfClass(TConstArrayView<UObject*> Objects, const UClass* Class, CallableType&& Callable)
+	{
+		if (!Class)
+		{
+			return;
+		}
+
+		const UClass* LastClass = nullptr;
+		bool bLastClassMatches = false;
+
+		for (UObject* Object : Objects)
+		{
+			if (!Object)
+			{
+				continue;
+			}
+
+			const UClass* ObjectClass = Object->GetClass();
+			if (ObjectClass != LastClass)
+			{
+				LastClass = ObjectClass;
+				bLastClassMatches = ObjectClass->IsChildOf(Class);
+			}
+
+			if (bLastClassMatches)
+			{
+				Invoke(Callable, Object);
+			}
+		}
+	}
+}
@@ -0,0 +1,120 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#pragma once
+
+#include "System/TCU_Timestamp.h"
+
+struct FTCU_CooldownHandle
+{
+	bool IsValid() const
+	{
+		return Index != INDEX_NONE;
+	}
+
+	bool operator==(const FTCU_CooldownHandle& Other) const
+	{
+		return Index == Other.Index && Serial == Other.Serial;
+	}
+
+	bool operator!=(const FTCU_CooldownHandle& Other) const
+	{
+		return !(*this == Other);
+	}
+
+	friend uint32 GetTypeHash(const FTCU_CooldownHandle& Handle)
+	{
+		return HashCombine(GetTypeHash(Handle.Index), GetTypeHash(Handle.Serial));
+	}
+
+	int32 Index = INDEX_NONE;
+	uint32 Serial = 0;
+};
+
+/**
+ * Container of many cooldowns that share the same clock. The time is fetched at most once per frame by Update, and
+ * every query compares against that, so checking whether a cooldown is ready is a single integer comparison.
+ *
+ * Expiry times are laid out as a structure of arrays indexed by handle, and additionally kept in a min-heap, so that
+ * the cooldowns that have expired since the last call can be collected in one batch without visiting the others.
+ *
+ *	Cooldowns.Update(this);
+ *	if (Cooldowns.IsReady(FireCooldown))
+ *	{
+ *		Fire();
+ *		Cooldowns.Restart(FireCooldown, FireInterval);
+ *	}
+ */
+class TONETFALCOMMONUTILITIES_API FTCU_Cooldowns
+{
+public:
+	explicit FTCU_Cooldowns(ETCU_TimeDomain InTimeDomain = ETCU_TimeDomain::Local);
+
+	/** Fetches the time of the world the context object belongs to. Does nothing if it's been done this frame. */
+	void Update(const UObject* ContextObject);
+
+	/** Sets the time to compare against explicitly. */
+	void SetNow(FTCU_Timestamp InNow);
+
+	FTCU_Timestamp GetNow() const;
+	ETCU_TimeDomain GetTimeDomain() const;
+
+	/** Starts a new cooldown that expires after the given duration counted from the current time. */
+	FTCU_CooldownHandle Start(double Duration);
+
+	/** Makes the cooldown expire after the given duration counted from the current time. */
+	void Restart(FTCU_CooldownHandle Handle, double Duration);
+
+	void Remove(FTCU_CooldownHandle Handle);
+	bool Contains(FTCU_CooldownHandle Handle) const;
+
+	/** Returns whether the cooldown has expired. Cooldowns that don't exist are considered ready. */
+	bool IsReady(FTCU_CooldownHandle Handle) const;
+
+	/** Returns the number of seconds left until the cooldown expires, or 0 if it's ready. */
+	double GetRemainingTime(FTCU_CooldownHandle Handle) const;
+
+	/**
+	 * Adds the cooldowns that have expired since the last collection to the array, in order of expiry. Each expiry is
+	 * reported once; restarting a cooldown makes it reportable again.
+	 */
+	void CollectExpired(TArray<FTCU_CooldownHandle>& OutExpired);
+
+	int32 Num() const;
+	void Reset();
+
+private:
+	struct FHeapEntry
+	{
+		int64 ExpiryTicks = 0;
+		int32 Index = INDEX_NONE;
+		uint32 Serial = 0;
+
+		bool operator<(const FHeapEntry& Other) const
+		{
+			return ExpiryTicks < Other.ExpiryTicks;
+		}
+	};
+
+	bool IsAlive(FTCU_CooldownHandle Handle) const;
+	void PushExpiry(int32 Index);
+	void CompactHeapIfNeeded();
+
+private:
+	ETCU_TimeDomain TimeDomain = ETCU_TimeDomain::Local;
+	FTCU_Timestamp Now;
+	uint64 LastUpdateFrame = MAX_uint64;
+
+	TArray<int64> ExpiryTicks;
+	TArray<uint32> Serials;
+	TBitArray<> AliveFlags;
+
+	/** Whether the current expiry of a cooldown hasn't been reported by CollectExpired yet. */
+	TBitArray<> PendingFlags;
+
+	TArray<int32> FreeIndices;
+
+	/** Restarted and removed cooldowns leave stale entries behind, they're skipped when popped. */
+	TArray<FHeapEntry> ExpiryHeap;
+
+	int32 AliveNum = 0;
+};
@@ -0,0 +1,115 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "System/TCU_Casts.h"
+#include "UObject/ObjectKey.h"
+
+#include "TCU_FrameworkObjectsSubsystem.generated.h"
+
+class AGameModeBase;
+class AGameStateBase;
+
+enum class ETCU_FrameworkObject : uint8
+{
+	GameMode,
+	GameState,
+	GameSession,
+	GameInstance,
+	WorldSettings,
+	Num
+};
+
+/**
+ * Per-world cache of the game framework objects, and of whether they're of the classes they've been asked for, so that
+ * typed getters called every frame don't have to fetch and cast them over and over. The cache of the game mode and
+ * the game session is dropped when a game mode is initialized, the one of the game state when it's set, and all of
+ * them on seamless travel.
+ *
+ * The cache is only used on the game thread; other threads always fetch and check the objects anew.
+ */
+UCLASS()
+class TONETFALCOMMONUTILITIES_API UTCU_FrameworkObjectsSubsystem
+	: public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Returns the subsystem of the world the context object belongs to, or null if the world doesn't have one. */
+	static UTCU_FrameworkObjectsSubsystem* Get(const UObject* ContextObject);
+
+	/**
+	 * Returns the framework object of the world the context object belongs to if it's of the given class. Uses the
+	 * cache of the world if it has one.
+	 */
+	static UObject* GetObjectOfClass(const UObject* ContextObject, ETCU_FrameworkObject Type, const UClass* Class);
+
+	/** Returns the framework object of the world the context object belongs to, whatever class it is. */
+	static UObject* GetObject(const UObject* ContextObject, ETCU_FrameworkObject Type);
+
+	//~UWorldSubsystem Interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of UWorldSubsystem Interface
+
+	/** Returns the framework object if it's of the given class. */
+	UObject* GetObjectOfClass(ETCU_FrameworkObject Type, const UClass* Class);
+
+	/** Returns the framework object, whatever class it is. */
+	UObject* GetObject(ETCU_FrameworkObject Type);
+
+	template<typename UserClass>
+	UserClass* GetObject(ETCU_FrameworkObject Type);
+
+	void Invalidate(ETCU_FrameworkObject Type);
+	void InvalidateAll();
+
+private:
+	static UObject* FetchObject(const UWorld* World, ETCU_FrameworkObject Type);
+
+	void OnGameModeInitialized(AGameModeBase* GameMode);
+	void OnGameStateSet(AGameStateBase* GameState);
+	void OnSeamlessTravelTransition(UWorld* World);
+
+private:
+	struct FClassMatch
+	{
+		TObjectKey<UClass> Class;
+		bool bMatches = false;
+	};
+
+	struct FCachedObject
+	{
+		TWeakObjectPtr<UObject> Object;
+
+		/** Classes the object has been checked against. Usually there's only one. */
+		TArray<FClassMatch, TInlineAllocator<2>> ClassMatches;
+	};
+
+	/** Returns the cached object, fetching it anew if there's none. */
+	UObject* GetCachedObject(FCachedObject& CachedObject, ETCU_FrameworkObject Type);
+
+	FCachedObject CachedObjects[static_cast<int32>(ETCU_FrameworkObject::Num)];
+
+	FDelegateHandle GameModeInitializedHandle;
+	FDelegateHandle GameStateSetHandle;
+	FDelegateHandle SeamlessTravelTransitionHandle;
+};
+
+template<typename UserClass>
+UserClass* UTCU_FrameworkObjectsSubsystem::GetObject(ETCU_FrameworkObject Type)
+{
+	if constexpr (std::is_final_v<UserClass>)
+	{
+		// Comparing the class is as cheap as looking up the cached class match, but blueprints can still derive from
+		// final native classes, so their objects have to go through the usual check
+		UObject* Object = GetObject(Type);
+		if (Object && Object->GetClass() == UserClass::StaticClass())
+		{
+			return static_cast<UserClass*>(Object);
+		}
+	}
+
+	return static_cast<UserClass*>(GetObjectOfClass(Type, UserClass::StaticClass()));
+}
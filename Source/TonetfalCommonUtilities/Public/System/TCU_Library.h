@@ -2,16 +2,42 @@
 
 #pragma once
 
+#include "Async/ParallelFor.h"
+#include "EngineUtils.h"
 #include "GameFramework/GameStateBase.h"
 #include "GameFramework/SaveGame.h"
 #include "GameplayTagContainer.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "Kismet/GameplayStatics.h"
+#include "UObject/StrongObjectPtr.h"
+#include "System/TCU_Casts.h"
+#include "System/TCU_FrameworkObjectsSubsystem.h"
+#include "System/TCU_ModuleHandle.h"
+#include "System/TCU_PlayerRanges.h"
+#include "System/TCU_SaveGamePoolSubsystem.h"
+#include "System/TCU_SaveGameStorage.h"
+#include "System/TCU_SectionedSaveGame.h"
+#include "System/TCU_Timestamp.h"
+#include "System/TCU_WeakObjectSet.h"
+#include "System/TCU_WorldResolver.h"
 
 #include "TCU_Library.generated.h"
 
 struct FEventReply;
 
+UENUM(BlueprintType)
+enum class ETCU_WhitespaceSet : uint8
+{
+	/** Space, line feed and carriage return. */
+	Default,
+
+	/** Space, tab, line feed, vertical tab, form feed and carriage return. */
+	Ascii,
+
+	/** Anything Unicode considers to be a whitespace, including non-breaking and ideographic spaces. */
+	Unicode,
+};
+
 UCLASS()
 class TONETFALCOMMONUTILITIES_API UTCU_Library
 	: public UBlueprintFunctionLibrary
@@ -58,6 +84,35 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Actor",
 		meta=(WorldContext="WorldContextObject", DeterminesOutputType="ActorClass"))
 	static AActor* GetActorOfClassWithTag(const UObject* WorldContextObject, TSubclassOf<AActor> ActorClass, FName Tag);
+
+	UFUNCTION(BlueprintCallable, Category="Actor",
+		meta=(WorldContext="WorldContextObject", DeterminesOutputType="ActorClass"))
+	static TArray<AActor*> GetActorsOfClassWithTag(const UObject* WorldContextObject, TSubclassOf<AActor> ActorClass,
+		FName Tag);
+
+	UFUNCTION(BlueprintCallable, Category="Actor",
+		meta=(WorldContext="WorldContextObject", DeterminesOutputType="ActorClass"))
+	static TArray<AActor*> GetActorsWithAllTags(const UObject* WorldContextObject, TSubclassOf<AActor> ActorClass,
+		const TArray<FName>& Tags);
+
+	UFUNCTION(BlueprintCallable, Category="Actor",
+		meta=(WorldContext="WorldContextObject", DeterminesOutputType="ActorClass"))
+	static TArray<AActor*> GetActorsWithAnyTag(const UObject* WorldContextObject, TSubclassOf<AActor> ActorClass,
+		const TArray<FName>& Tags);
+
+	/**
+	 * Adds a tag to the actor, and lets the actor index know about it. When the tag index is enabled, tags added to
+	 * AActor::Tags directly must be reported with UTCU_ActorIndexSubsystem::NotifyActorTagsChanged instead.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Actor")
+	static void AddActorTag(AActor* Actor, FName Tag);
+
+	/**
+	 * Removes a tag from the actor. The actor index isn't notified, as its queries check the tags of the actors they
+	 * find, and drop the ones that no longer have them lazily.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Actor")
+	static void RemoveActorTag(AActor* Actor, FName Tag);
 #pragma endregion
 
 #pragma region Player
@@ -148,6 +203,126 @@ public:
 	UFUNCTION(BlueprintPure, Category="Game|Time|Explicit", meta=(DefaultToSelf="ContextObject",
 		CompactNodeTitle="Time Since (Server)", BlueprintThreadSafe))
 	static float TimeSince_Server_Explicit(const UObject* ContextObject, float Time);
+
+	UFUNCTION(BlueprintPure, Category="Game|Time", meta=(DefaultToSelf="ContextObject", HidePin="ContextObject",
+		CompactNodeTitle="Get Time (Double)", BlueprintThreadSafe))
+	static double GetTime_Double(const UObject* ContextObject);
+
+	UFUNCTION(BlueprintPure, Category="Game|Time", meta=(DefaultToSelf="ContextObject", HidePin="ContextObject",
+		CompactNodeTitle="Time Since (Double)", BlueprintThreadSafe))
+	static double TimeSince_Double(const UObject* ContextObject, double Time);
+
+	UFUNCTION(BlueprintPure, Category="Game|Time", meta=(DefaultToSelf="ContextObject", HidePin="ContextObject",
+		CompactNodeTitle="Get Time (Server, Double)", BlueprintThreadSafe))
+	static double GetTime_Server_Double(const UObject* ContextObject);
+
+	UFUNCTION(BlueprintPure, Category="Game|Time", meta=(DefaultToSelf="ContextObject", HidePin="ContextObject",
+		CompactNodeTitle="Time Since (Server, Double)", BlueprintThreadSafe))
+	static double TimeSince_Server_Double(const UObject* ContextObject, double Time);
+
+	UFUNCTION(BlueprintPure, Category="Game|Time", meta=(DefaultToSelf="ContextObject", HidePin="ContextObject",
+		CompactNodeTitle="Get Timestamp", BlueprintThreadSafe))
+	static FTCU_Timestamp GetTimestamp(const UObject* ContextObject);
+
+	UFUNCTION(BlueprintPure, Category="Game|Time", meta=(DefaultToSelf="ContextObject", HidePin="ContextObject",
+		CompactNodeTitle="Ticks Since", BlueprintThreadSafe))
+	static int64 TicksSince(const UObject* ContextObject, FTCU_Timestamp Timestamp);
+
+	UFUNCTION(BlueprintPure, Category="Game|Time", meta=(DefaultToSelf="ContextObject", HidePin="ContextObject",
+		CompactNodeTitle="Get Timestamp (Server)", BlueprintThreadSafe))
+	static FTCU_Timestamp GetTimestamp_Server(const UObject* ContextObject);
+
+	UFUNCTION(BlueprintPure, Category="Game|Time", meta=(DefaultToSelf="ContextObject", HidePin="ContextObject",
+		CompactNodeTitle="Ticks Since (Server)", BlueprintThreadSafe))
+	static int64 TicksSince_Server(const UObject* ContextObject, FTCU_Timestamp Timestamp);
+
+	UFUNCTION(BlueprintPure, Category="Game|Time|Explicit", meta=(DefaultToSelf="ContextObject",
+		CompactNodeTitle="Get Time (Double)", BlueprintThreadSafe))
+	static double GetTime_Double_Explicit(const UObject* ContextObject);
+
+	UFUNCTION(BlueprintPure, Category="Game|Time|Explicit", meta=(DefaultToSelf="ContextObject",
+		CompactNodeTitle="Time Since (Double)", BlueprintThreadSafe))
+	static double TimeSince_Double_Explicit(const UObject* ContextObject, double Time);
+
+	UFUNCTION(BlueprintPure, Category="Game|Time|Explicit", meta=(DefaultToSelf="ContextObject",
+		CompactNodeTitle="Get Time (Server, Double)", BlueprintThreadSafe))
+	static double GetTime_Server_Double_Explicit(const UObject* ContextObject);
+
+	UFUNCTION(BlueprintPure, Category="Game|Time|Explicit", meta=(DefaultToSelf="ContextObject",
+		CompactNodeTitle="Time Since (Server, Double)", BlueprintThreadSafe))
+	static double TimeSince_Server_Double_Explicit(const UObject* ContextObject, double Time);
+
+	UFUNCTION(BlueprintPure, Category="Game|Time|Explicit", meta=(DefaultToSelf="ContextObject",
+		CompactNodeTitle="Get Timestamp", BlueprintThreadSafe))
+	static FTCU_Timestamp GetTimestamp_Explicit(const UObject* ContextObject);
+
+	UFUNCTION(BlueprintPure, Category="Game|Time|Explicit", meta=(DefaultToSelf="ContextObject",
+		CompactNodeTitle="Ticks Since", BlueprintThreadSafe))
+	static int64 TicksSince_Explicit(const UObject* ContextObject, FTCU_Timestamp Timestamp);
+
+	UFUNCTION(BlueprintPure, Category="Game|Time|Explicit", meta=(DefaultToSelf="ContextObject",
+		CompactNodeTitle="Get Timestamp (Server)", BlueprintThreadSafe))
+	static FTCU_Timestamp GetTimestamp_Server_Explicit(const UObject* ContextObject);
+
+	UFUNCTION(BlueprintPure, Category="Game|Time|Explicit", meta=(DefaultToSelf="ContextObject",
+		CompactNodeTitle="Ticks Since (Server)", BlueprintThreadSafe))
+	static int64 TicksSince_Server_Explicit(const UObject* ContextObject, FTCU_Timestamp Timestamp);
+
+	/**
+	 * Smoothed versions of the server time. Unlike the raw server time, it doesn't jump whenever a correction arrives
+	 * and never goes backwards. See UTCU_ServerClockSubsystem.
+	 */
+	UFUNCTION(BlueprintPure, Category="Game|Time", meta=(DefaultToSelf="ContextObject", HidePin="ContextObject",
+		CompactNodeTitle="Get Time (Server, Smoothed)", BlueprintThreadSafe))
+	static double GetTime_Server_Smoothed(const UObject* ContextObject);
+
+	UFUNCTION(BlueprintPure, Category="Game|Time", meta=(DefaultToSelf="ContextObject", HidePin="ContextObject",
+		CompactNodeTitle="Time Since (Server, Smoothed)", BlueprintThreadSafe))
+	static double TimeSince_Server_Smoothed(const UObject* ContextObject, double Time);
+
+	UFUNCTION(BlueprintPure, Category="Game|Time", meta=(DefaultToSelf="ContextObject", HidePin="ContextObject",
+		CompactNodeTitle="Get Timestamp (Server, Smoothed)", BlueprintThreadSafe))
+	static FTCU_Timestamp GetTimestamp_Server_Smoothed(const UObject* ContextObject);
+
+	UFUNCTION(BlueprintPure, Category="Game|Time", meta=(DefaultToSelf="ContextObject", HidePin="ContextObject",
+		CompactNodeTitle="Ticks Since (Server, Smoothed)", BlueprintThreadSafe))
+	static int64 TicksSince_Server_Smoothed(const UObject* ContextObject, FTCU_Timestamp Timestamp);
+
+	UFUNCTION(BlueprintPure, Category="Game|Time|Explicit", meta=(DefaultToSelf="ContextObject",
+		CompactNodeTitle="Get Time (Server, Smoothed)", BlueprintThreadSafe))
+	static double GetTime_Server_Smoothed_Explicit(const UObject* ContextObject);
+
+	UFUNCTION(BlueprintPure, Category="Game|Time|Explicit", meta=(DefaultToSelf="ContextObject",
+		CompactNodeTitle="Time Since (Server, Smoothed)", BlueprintThreadSafe))
+	static double TimeSince_Server_Smoothed_Explicit(const UObject* ContextObject, double Time);
+
+	UFUNCTION(BlueprintPure, Category="Game|Time|Explicit", meta=(DefaultToSelf="ContextObject",
+		CompactNodeTitle="Get Timestamp (Server, Smoothed)", BlueprintThreadSafe))
+	static FTCU_Timestamp GetTimestamp_Server_Smoothed_Explicit(const UObject* ContextObject);
+
+	UFUNCTION(BlueprintPure, Category="Game|Time|Explicit", meta=(DefaultToSelf="ContextObject",
+		CompactNodeTitle="Ticks Since (Server, Smoothed)", BlueprintThreadSafe))
+	static int64 TicksSince_Server_Smoothed_Explicit(const UObject* ContextObject, FTCU_Timestamp Timestamp);
+
+	/** Returns the number of microseconds between the two timestamps. */
+	UFUNCTION(BlueprintPure, Category="Game|Time|Timestamp", meta=(DisplayName="Timestamp - Timestamp",
+		CompactNodeTitle="-", BlueprintThreadSafe))
+	static int64 Subtract_TimestampTimestamp(FTCU_Timestamp A, FTCU_Timestamp B);
+
+	UFUNCTION(BlueprintPure, Category="Game|Time|Timestamp", meta=(DisplayName="Timestamp < Timestamp",
+		CompactNodeTitle="<", BlueprintThreadSafe))
+	static bool Less_TimestampTimestamp(FTCU_Timestamp A, FTCU_Timestamp B);
+
+	UFUNCTION(BlueprintPure, Category="Game|Time|Timestamp", meta=(DisplayName="Timestamp > Timestamp",
+		CompactNodeTitle=">", BlueprintThreadSafe))
+	static bool Greater_TimestampTimestamp(FTCU_Timestamp A, FTCU_Timestamp B);
+
+	UFUNCTION(BlueprintPure, Category="Game|Time|Timestamp", meta=(DisplayName="To Seconds (Timestamp)",
+		CompactNodeTitle="->", BlueprintAutocast, BlueprintThreadSafe))
+	static double Conv_TimestampToSeconds(FTCU_Timestamp Timestamp);
+
+	UFUNCTION(BlueprintPure, Category="Game|Time|Timestamp", meta=(BlueprintThreadSafe))
+	static FTCU_Timestamp MakeTimestampFromSeconds(double Seconds);
 #pragma endregion
 
 #pragma region Gameplay Tags
@@ -167,8 +342,9 @@ public:
 #pragma endregion
 
 #pragma region Misc
+	/** Returns the objects of the array that are of the class, keeping their order. Nulls are left out. */
 	UFUNCTION(BlueprintPure, Category="Game|Misc", meta=(DeterminesOutputType="Class"))
-	static TArray<UObject*> CastArray(TArray<UObject*> Array, TSubclassOf<UObject> Class);
+	static TArray<UObject*> CastArray(const TArray<UObject*>& Array, TSubclassOf<UObject> Class);
 
 	UFUNCTION(BlueprintCallable, Category="Game|Misc", DisplayName="Stack Trace (C++)")
 	static void CppStackTrace(FString Heading);
@@ -202,6 +378,14 @@ public:
 	static APlayerStart* FindPlayerStart(const APlayerController* Controller, const FString& IncomingName,
 		const TSubclassOf<APawn> PawnClass);
 
+	/**
+	 * Picks player starts for many controllers at once, e.g. when a round restarts. Unlike calling FindPlayerStart for
+	 * each of them, every controller gets a distinct player start for as long as there are enough of them.
+	 */
+	UFUNCTION(BlueprintPure="False", Category="Game|Misc")
+	static TArray<APlayerStart*> FindPlayerStarts(const TArray<APlayerController*>& Controllers,
+		const FString& IncomingName, const TSubclassOf<APawn> PawnClass);
+
 	UFUNCTION(BlueprintCallable, Category="Game|Misc")
 	static void ClipboardCopy(const FString& String);
 
@@ -235,13 +419,16 @@ public:
 
 #pragma region String
 	UFUNCTION(BlueprintCallable, Category="Game|String")
-	static FString TrimLeadingSpaces(FString InString, bool& bOutHasTrimmed);
+	static FString TrimLeadingSpaces(FString InString, bool& bOutHasTrimmed,
+		ETCU_WhitespaceSet Whitespace = ETCU_WhitespaceSet::Default);
 
 	UFUNCTION(BlueprintCallable, Category="Game|String")
-	static FString TrimTrailingSpaces(FString InString, bool& bOutHasTrimmed);
+	static FString TrimTrailingSpaces(FString InString, bool& bOutHasTrimmed,
+		ETCU_WhitespaceSet Whitespace = ETCU_WhitespaceSet::Default);
 
 	UFUNCTION(BlueprintCallable, Category="Game|String")
-	static FString TrimSurroundingSpaces(FString InString, bool& bOutHasTrimmed);
+	static FString TrimSurroundingSpaces(FString InString, bool& bOutHasTrimmed,
+		ETCU_WhitespaceSet Whitespace = ETCU_WhitespaceSet::Default);
 
 	UFUNCTION(BlueprintCallable, Category="Game|String")
 	static FString LimitString(FString InString, int32 Limit, bool& bOutLimited);
@@ -274,6 +461,7 @@ public:
 	template <typename UserClass = ULocalPlayer>
 	[[nodiscard]] static UserClass* GetLocalPlayer(const UObject* ContextObject, int32 PlayerIndex);
 
+	/** Returns the module, or null if it isn't loaded. Lookups are cached per module type, see FTCU_ModuleHandle. */
 	template <typename UserClass>
 	[[nodiscard]] static UserClass* GetModule(const FName& Name);
 
@@ -283,6 +471,63 @@ public:
 	template<typename UserClass>
 	[[nodiscard]] static TArray<UserClass*> GetActorsOfClass(const UObject* WorldContextObject);
 
+	/** Appends the actors of the class to the array, which can use an inline allocator to avoid growing on the heap. */
+	template<typename UserClass, typename AllocatorType>
+	static void GetActorsOfClass(const UObject* WorldContextObject, TArray<UserClass*, AllocatorType>& OutActors);
+
+	/**
+	 * Calls the callable on each actor of the class. If the callable returns a bool, returning false stops the
+	 * iteration. The actors are iterated with TActorIterator, which still gathers the objects of the class into an
+	 * array of its own, but nothing is allocated per actor or for the results.
+	 */
+	template<typename UserClass, typename CallableType>
+	static void ForEachActorOfClass(const UObject* WorldContextObject, CallableType&& Callable);
+
+	/**
+	 * Snapshots the actors of the class, and evaluates the predicate on them in parallel, chunk by chunk. Returns the
+	 * actors the predicate accepts, in the order they've been iterated in. Meant for costly predicates evaluated on a
+	 * lot of actors; cheap ones are faster to run with ForEachActorOfClass.
+	 *
+	 * Must be called from the game thread, which is blocked until the query is done. The predicate runs on worker
+	 * threads, so it may only read state that nothing modifies meanwhile: properties of the actor it's given, its
+	 * tags, class and interface checks, transforms of its components, and its own captures. It must not modify any
+	 * other state, create or destroy objects, call Blueprint functions, or call anything that is meant to be used on
+	 * the game thread only.
+	 */
+	template<typename UserClass, typename PredicateType>
+	[[nodiscard]] static TArray<UserClass*> ParallelQueryActors(const UObject* WorldContextObject,
+		PredicateType&& Predicate, int32 ChunkSize = 256);
+
+	template<typename UserClass, typename PredicateType, typename AllocatorType>
+	static void ParallelQueryActors(const UObject* WorldContextObject, PredicateType&& Predicate,
+		TArray<UserClass*, AllocatorType>& OutActors, int32 ChunkSize = 256);
+
+#pragma region Player
+	template<typename UserClass = APlayerController>
+	[[nodiscard]] static TTCU_PlayerControllerRange<UserClass> GetPlayerControllers(const UObject* ContextObject,
+		bool bLocalOnly = false);
+
+	template<typename UserClass = APlayerState>
+	[[nodiscard]] static TTCU_PlayerStateRange<UserClass> GetPlayerStates(const UObject* ContextObject,
+		bool bLocalOnly = false);
+
+	template<typename UserClass = APawn>
+	[[nodiscard]] static TTCU_PlayerPawnRange<UserClass> GetPlayerPawns(const UObject* ContextObject,
+		bool bLocalOnly = false);
+
+	template<typename UserClass, typename AllocatorType>
+	static void GetPlayerControllers(const UObject* ContextObject, bool bLocalOnly,
+		TArray<UserClass*, AllocatorType>& OutPlayerControllers);
+
+	template<typename UserClass, typename AllocatorType>
+	static void GetPlayerStates(const UObject* ContextObject, bool bLocalOnly,
+		TArray<UserClass*, AllocatorType>& OutPlayerStates);
+
+	template<typename UserClass, typename AllocatorType>
+	static void GetPlayerPawns(const UObject* ContextObject, bool bLocalOnly,
+		TArray<UserClass*, AllocatorType>& OutPlayerPawns);
+#pragma endregion
+
 #pragma region Checked
 	template <typename UserClass = AGameModeBase>
 	[[nodiscard]] static UserClass* GetGameMode_Checked(const UObject* ContextObject);
@@ -311,11 +556,39 @@ public:
 #pragma endregion
 
 #pragma region SaveGame
+	/**
+	 * Creates a save game object.
+	 * @param	bUsePool If true, the object is taken from the pool of UTCU_SaveGamePoolSubsystem if there's one, and
+	 *			should be given back with ReleaseSaveGameObject once it's not needed anymore.
+	 */
 	template <typename UserClass>
-	[[nodiscard]] static UserClass* CreateSaveGameObject();
+	[[nodiscard]] static UserClass* CreateSaveGameObject(bool bUsePool = false);
+
+	/** Returns a save game object created from the pool. It must not be used anymore. */
+	static void ReleaseSaveGameObject(USaveGame* SaveGame);
 
 	template <typename UserClass>
 	[[nodiscard]] static UserClass* LoadGameFromSlot(const FString& SlotName, const int32 UserIndex);
+
+	/**
+	 * Serializes the object right away, and compresses and writes it on a worker thread. See FTCU_SaveGameStorage.
+	 * @return	Future that is fulfilled by a worker thread with whether the slot has been written.
+	 */
+	static TFuture<bool> SaveGameToSlotAsync(USaveGame* SaveGame, const FString& SlotName,
+		ETCU_SaveGameCompression Compression = ETCU_SaveGameCompression::Oodle);
+
+	/**
+	 * Reads and decompresses a slot written by SaveGameToSlotAsync on a worker thread, and creates the object on the
+	 * game thread. See FTCU_SaveGameStorage.
+	 * @return	Future that is fulfilled on the game thread with the loaded object, or null if the slot couldn't be
+	 *			loaded or isn't of the class. The object is kept alive for as long as it's referenced by the result.
+	 */
+	template <typename UserClass>
+	[[nodiscard]] static TFuture<TStrongObjectPtr<UserClass>> LoadGameFromSlotAsync(const FString& SlotName);
+
+	/** Opens a sectioned slot without deserializing any of its sections. See UTCU_SectionedSaveGame. */
+	template <typename UserClass>
+	[[nodiscard]] static UserClass* LoadSectionedGameFromSlot(const FString& SlotName);
 #pragma endregion
 
 #pragma region Misc
@@ -333,6 +606,42 @@ public:
 	[[nodiscard]] static TArray<const UserClass*> FromWeakObjectPtrArray(
 		const TArray<TWeakObjectPtr<const UserClass>>& Array);
 
+	/** Appends weak pointers to the objects to the array. */
+	template <typename UserClass, typename InAllocatorType, typename OutAllocatorType>
+	static void ToWeakObjectPtrArray(const TArray<UserClass*, InAllocatorType>& Array,
+		TArray<TWeakObjectPtr<UserClass>, OutAllocatorType>& OutArray);
+
+	/** Appends the objects the weak pointers point to, with nulls in place of the stale ones. */
+	template <typename UserClass, typename InAllocatorType, typename OutAllocatorType>
+	static void FromWeakObjectPtrArray(const TArray<TWeakObjectPtr<UserClass>, InAllocatorType>& Array,
+		TArray<UserClass*, OutAllocatorType>& OutArray);
+
+	/** Appends the objects the weak pointers point to, skipping the stale ones. */
+	template <typename UserClass, typename InAllocatorType, typename OutAllocatorType>
+	static void ResolveWeakObjectPtrs(const TArray<TWeakObjectPtr<UserClass>, InAllocatorType>& Array,
+		TArray<UserClass*, OutAllocatorType>& OutObjects);
+
+	/**
+	 * Removes the stale weak pointers from the array in place, keeping its allocation.
+	 * @param	bStable If true, the order of the remaining elements is kept. Otherwise, the removed elements are
+	 *			replaced with the last ones, which moves fewer elements.
+	 * @return	Number of removed elements.
+	 */
+	template <typename UserClass, typename AllocatorType>
+	static int32 CompactWeakArray(TArray<TWeakObjectPtr<UserClass>, AllocatorType>& Array, bool bStable = true);
+
+	/**
+	 * Removes the stale weak pointers from the array, and appends the objects the remaining ones point to, in a single
+	 * pass that keeps the order. Meant for arrays that are resolved over and over, e.g. every tick.
+	 */
+	template <typename UserClass, typename InAllocatorType, typename OutAllocatorType>
+	static void ResolveAndCompactWeakArray(TArray<TWeakObjectPtr<UserClass>, InAllocatorType>& Array,
+		TArray<UserClass*, OutAllocatorType>& OutObjects);
+
+	/** Appends the objects of the array that are of the class, keeping their order. Nulls are left out. */
+	template <typename UserClass, typename AllocatorType>
+	static void CastArray(TConstArrayView<UObject*> Array, TArray<UserClass*, AllocatorType>& OutArray);
+
 	template <typename UserClass>
 	[[nodiscard]] static UserClass GetArrayElem(const TArray<UserClass>& Array, int32 Index, UserClass ReturnIfEmpty);
 
@@ -344,102 +653,128 @@ public:
 
 	static bool IsWorldType(const UObject* ContextObject, EWorldType::Type Type);
 #pragma endregion
+
+#pragma region String
+	/**
+	 * Non-allocating versions of the trimming functions. The returned view points into the given string, so it must
+	 * not outlive it; don't pass temporaries.
+	 */
+	[[nodiscard]] static FStringView TrimLeadingSpaces(FStringView InString,
+		ETCU_WhitespaceSet Whitespace = ETCU_WhitespaceSet::Default);
+
+	[[nodiscard]] static FStringView TrimTrailingSpaces(FStringView InString,
+		ETCU_WhitespaceSet Whitespace = ETCU_WhitespaceSet::Default);
+
+	[[nodiscard]] static FStringView TrimSurroundingSpaces(FStringView InString,
+		ETCU_WhitespaceSet Whitespace = ETCU_WhitespaceSet::Default);
+
+	static bool IsSpace(TCHAR Character, ETCU_WhitespaceSet Whitespace = ETCU_WhitespaceSet::Default);
+
+	/**
+	 * Appends the string Count times. The destination grows once to its final length, and is filled by copying the
+	 * already written part over and over. The string must not point into the destination.
+	 */
+	static void AppendRepeated(FString& OutString, FStringView String, int32 Count);
+	static void AppendRepeated(FStringBuilderBase& OutBuilder, FStringView String, int32 Count);
+
+	/** Appends the strings with the separator between each of them. The destination grows only once. */
+	static void AppendJoined(FString& OutString, TConstArrayView<FStringView> Strings, FStringView Separator);
+	static void AppendJoined(FStringBuilderBase& OutBuilder, TConstArrayView<FStringView> Strings,
+		FStringView Separator);
+
+	/** Joins the strings with the separator between each of them. The result is allocated only once. */
+	[[nodiscard]] static FString Join(TConstArrayView<FStringView> Strings, FStringView Separator);
+	[[nodiscard]] static FString Join(TConstArrayView<FString> Strings, FStringView Separator);
+
+	/** Joins the strings one after another. The result is allocated only once. */
+	[[nodiscard]] static FString Concat(TConstArrayView<FStringView> Strings);
+#pragma endregion
 #pragma endregion
 };
 
 #pragma region C++
 #pragma region TypedGetters
-template<typename UserClass>
-UserClass* UTCU_Library::GetGameMode(const UObject* ContextObject)
+namespace TCU::Private
 {
-	const UWorld* World = GEngine->GetWorldFromContextObject(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
-	if (!IsValid(World))
-	{
-		return nullptr;
-	}
-
-	AGameModeBase* BaseGameMode = World->GetAuthGameMode();
-	if (!IsValid(BaseGameMode))
+	/**
+	 * Returns the framework object if it's of the class. The cached class match is only looked up when it can't be
+	 * figured out from the types alone.
+	 */
+	template<typename UserClass, typename BaseClass>
+	UserClass* GetFrameworkObject(const UObject* ContextObject, ETCU_FrameworkObject Type)
 	{
-		return nullptr;
+		if constexpr (std::is_base_of_v<UserClass, BaseClass> || std::is_final_v<UserClass>)
+		{
+			UObject* Object = UTCU_FrameworkObjectsSubsystem::GetObject(ContextObject, Type);
+			return CastToClass<UserClass>(static_cast<BaseClass*>(Object));
+		}
+		else
+		{
+			UObject* Object = UTCU_FrameworkObjectsSubsystem::GetObjectOfClass(ContextObject, Type,
+				UserClass::StaticClass());
+			return static_cast<UserClass*>(Object);
+		}
 	}
+}
 
-	auto* TypedGameMode = Cast<UserClass>(BaseGameMode);
-	return TypedGameMode;
+template<typename UserClass>
+UserClass* UTCU_Library::GetGameMode(const UObject* ContextObject)
+{
+	return TCU::Private::GetFrameworkObject<UserClass, AGameModeBase>(ContextObject, ETCU_FrameworkObject::GameMode);
 }
 
 template<typename UserClass>
 UserClass* UTCU_Library::GetGameState(const UObject* ContextObject)
 {
-	const UWorld* World = GEngine->GetWorldFromContextObject(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
-	if (!IsValid(World))
-	{
-		return nullptr;
-	}
-
-	auto* TypedGameState = World->GetGameState<UserClass>();
-	return TypedGameState;
+	return TCU::Private::GetFrameworkObject<UserClass, AGameStateBase>(ContextObject, ETCU_FrameworkObject::GameState);
 }
 
 template<typename UserClass>
 UserClass* UTCU_Library::GetGameSession(const UObject* ContextObject)
 {
-	const UWorld* World = GEngine->GetWorldFromContextObject(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
-	if (!IsValid(World))
-	{
-		return nullptr;
-	}
-
-	AGameModeBase* BaseGameMode = World->GetAuthGameMode();
-	if (!IsValid(BaseGameMode))
-	{
-		return nullptr;
-	}
-
-	auto* TypedGameSession = Cast<UserClass>(BaseGameMode->GameSession);
-	return TypedGameSession;
+	return TCU::Private::GetFrameworkObject<UserClass, AGameSession>(ContextObject, ETCU_FrameworkObject::GameSession);
 }
 
 template<typename UserClass>
 UserClass* UTCU_Library::GetGameInstance(const UObject* ContextObject)
 {
-	const UWorld* World = GEngine->GetWorldFromContextObject(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
-	if (!IsValid(World))
-	{
-		return nullptr;
-	}
-
-	auto* TypedGameInstance = World->GetGameInstance<UserClass>();
-	return TypedGameInstance;
+	return TCU::Private::GetFrameworkObject<UserClass, UGameInstance>(ContextObject,
+		ETCU_FrameworkObject::GameInstance);
 }
 
 template<typename UserClass>
 UserClass* UTCU_Library::GetWorldSettings(const UObject* ContextObject)
 {
-	const UWorld* World = GEngine->GetWorldFromContextObject(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
-	if (!IsValid(World))
-	{
-		return nullptr;
-	}
-
-	AWorldSettings* WorldSettings = World->GetWorldSettings();
-	auto* TypedWorldSettings = Cast<UserClass>(WorldSettings);
-	return TypedWorldSettings;
+	return TCU::Private::GetFrameworkObject<UserClass, AWorldSettings>(ContextObject,
+		ETCU_FrameworkObject::WorldSettings);
 }
 
 template<typename UserClass>
 UserClass* UTCU_Library::GetPlayerController(const UObject* ContextObject, int32 PlayerIndex)
 {
-	APlayerController* Controller = UGameplayStatics::GetPlayerController(ContextObject, PlayerIndex);
+	const UWorld* World = FTCU_WorldResolver::Resolve(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (!IsValid(World))
+	{
+		return nullptr;
+	}
 
-	auto* TypedPlayerController = Cast<UserClass>(Controller);
-	return TypedPlayerController;
+	int32 Index = 0;
+	for (FConstPlayerControllerIterator Iterator = World->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		if (Index++ == PlayerIndex)
+		{
+			auto* TypedPlayerController = TCU::Private::CastToClass<UserClass>(Iterator->Get());
+			return TypedPlayerController;
+		}
+	}
+
+	return nullptr;
 }
 
 template<typename UserClass>
 UserClass* UTCU_Library::GetLocalPlayer(const UObject* ContextObject, int32 PlayerIndex)
 {
-	APlayerController* Controller = UGameplayStatics::GetPlayerController(ContextObject, PlayerIndex);
+	APlayerController* Controller = GetPlayerController(ContextObject, PlayerIndex);
 
 	if (!IsValid(Controller))
 	{
@@ -448,13 +783,20 @@ UserClass* UTCU_Library::GetLocalPlayer(const UObject* ContextObject, int32 Play
 
 	ULocalPlayer* LocalPlayer = Controller->GetLocalPlayer();
 
-	auto* TypedLocalPlayer = Cast<UserClass>(LocalPlayer);
+	auto* TypedLocalPlayer = TCU::Private::CastToClass<UserClass>(LocalPlayer);
 	return TypedLocalPlayer;
 }
 
 template<typename UserClass>
 UserClass* UTCU_Library::GetModule(const FName& Name)
 {
+	// Each type of module is usually only ever looked up by its own name; others don't use the cache
+	static const TTCU_ModuleHandle<UserClass> Handle(Name);
+	if (Handle.GetModuleName() == Name)
+	{
+		return Handle.Get();
+	}
+
 	IModuleInterface* Interface = FModuleManager::Get().GetModule(Name);
 	return Interface ? static_cast<UserClass*>(Interface) : nullptr;
 }
@@ -462,8 +804,12 @@ UserClass* UTCU_Library::GetModule(const FName& Name)
 template<typename UserClass>
 UserClass* UTCU_Library::GetActorOfClass(const UObject* WorldContextObject)
 {
-	AActor* Actor = UGameplayStatics::GetActorOfClass(WorldContextObject, UserClass::StaticClass());
-	auto* TypedActor = Cast<UserClass>(Actor);
+	UserClass* TypedActor = nullptr;
+	ForEachActorOfClass<UserClass>(WorldContextObject, [&TypedActor](UserClass* Actor)
+	{
+		TypedActor = Actor;
+		return false;
+	});
 
 	return TypedActor;
 }
@@ -471,15 +817,150 @@ UserClass* UTCU_Library::GetActorOfClass(const UObject* WorldContextObject)
 template<typename UserClass>
 TArray<UserClass*> UTCU_Library::GetActorsOfClass(const UObject* WorldContextObject)
 {
-	TArray<AActor*> Actors;
-	UGameplayStatics::GetAllActorsOfClass(WorldContextObject, UserClass::StaticClass(), OUT Actors);
+	TArray<UserClass*> TypedActors;
+	GetActorsOfClass<UserClass>(WorldContextObject, TypedActors);
+
+	return TypedActors;
+}
+
+template<typename UserClass, typename AllocatorType>
+void UTCU_Library::GetActorsOfClass(const UObject* WorldContextObject, TArray<UserClass*, AllocatorType>& OutActors)
+{
+	ForEachActorOfClass<UserClass>(WorldContextObject, [&OutActors](UserClass* Actor)
+	{
+		OutActors.Add(Actor);
+	});
+}
+
+template<typename UserClass, typename CallableType>
+void UTCU_Library::ForEachActorOfClass(const UObject* WorldContextObject, CallableType&& Callable)
+{
+	const UWorld* World = FTCU_WorldResolver::Resolve(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (!IsValid(World))
+	{
+		return;
+	}
+
+	// The iterator already filters by the class, so the actors don't need to be cast
+	for (TActorIterator<UserClass> Iterator(World); Iterator; ++Iterator)
+	{
+		if constexpr (std::is_same_v<decltype(Invoke(Callable, *Iterator)), bool>)
+		{
+			if (!Invoke(Callable, *Iterator))
+			{
+				return;
+			}
+		}
+		else
+		{
+			Invoke(Callable, *Iterator);
+		}
+	}
+}
 
+template<typename UserClass, typename PredicateType>
+TArray<UserClass*> UTCU_Library::ParallelQueryActors(const UObject* WorldContextObject, PredicateType&& Predicate,
+	int32 ChunkSize)
+{
 	TArray<UserClass*> TypedActors;
-	TypedActors.Append(Actors);
+	ParallelQueryActors<UserClass>(WorldContextObject, Predicate, TypedActors, ChunkSize);
 
 	return TypedActors;
 }
 
+template<typename UserClass, typename PredicateType, typename AllocatorType>
+void UTCU_Library::ParallelQueryActors(const UObject* WorldContextObject, PredicateType&& Predicate,
+	TArray<UserClass*, AllocatorType>& OutActors, int32 ChunkSize)
+{
+	check(IsInGameThread());
+
+	TArray<UserClass*> Actors;
+	GetActorsOfClass<UserClass>(WorldContextObject, Actors);
+
+	ChunkSize = FMath::Max(ChunkSize, 1);
+	const int32 ChunksNum = FMath::DivideAndRoundUp(Actors.Num(), ChunkSize);
+
+	// Each chunk only writes into its own bucket, so they don't need to be synchronized, and they're merged in order
+	// afterward so that the result doesn't depend on the scheduling
+	TArray<TArray<UserClass*>> Buckets;
+	Buckets.SetNum(ChunksNum);
+
+	ParallelFor(ChunksNum, [&](int32 ChunkIndex)
+	{
+		const int32 FirstIndex = ChunkIndex * ChunkSize;
+		const int32 LastIndex = FMath::Min(FirstIndex + ChunkSize, Actors.Num());
+
+		// Gather locally, as the buckets lie next to each other and would be falsely shared while growing
+		TArray<UserClass*> Matches;
+		for (int32 Index = FirstIndex; Index < LastIndex; Index++)
+		{
+			if (Invoke(Predicate, Actors[Index]))
+			{
+				Matches.Add(Actors[Index]);
+			}
+		}
+
+		Buckets[ChunkIndex] = MoveTemp(Matches);
+	}, ChunksNum > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+	int32 MatchesNum = 0;
+	for (const TArray<UserClass*>& Bucket : Buckets)
+	{
+		MatchesNum += Bucket.Num();
+	}
+
+	OutActors.Reserve(OutActors.Num() + MatchesNum);
+	for (const TArray<UserClass*>& Bucket : Buckets)
+	{
+		OutActors.Append(Bucket);
+	}
+}
+
+#pragma region Player
+template<typename UserClass>
+TTCU_PlayerControllerRange<UserClass> UTCU_Library::GetPlayerControllers(const UObject* ContextObject,
+	bool bLocalOnly)
+{
+	const UWorld* World = FTCU_WorldResolver::Resolve(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	return TTCU_PlayerControllerRange<UserClass>(World, bLocalOnly);
+}
+
+template<typename UserClass>
+TTCU_PlayerStateRange<UserClass> UTCU_Library::GetPlayerStates(const UObject* ContextObject, bool bLocalOnly)
+{
+	const UWorld* World = FTCU_WorldResolver::Resolve(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	return TTCU_PlayerStateRange<UserClass>(World, bLocalOnly);
+}
+
+template<typename UserClass>
+TTCU_PlayerPawnRange<UserClass> UTCU_Library::GetPlayerPawns(const UObject* ContextObject, bool bLocalOnly)
+{
+	const UWorld* World = FTCU_WorldResolver::Resolve(ContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	return TTCU_PlayerPawnRange<UserClass>(World, bLocalOnly);
+}
+
+template<typename UserClass, typename AllocatorType>
+void UTCU_Library::GetPlayerControllers(const UObject* ContextObject, bool bLocalOnly,
+	TArray<UserClass*, AllocatorType>& OutPlayerControllers)
+{
+	TCU::Private::AppendRange(GetPlayerControllers<UserClass>(ContextObject, bLocalOnly), OutPlayerControllers);
+}
+
+template<typename UserClass, typename AllocatorType>
+void UTCU_Library::GetPlayerStates(const UObject* ContextObject, bool bLocalOnly,
+	TArray<UserClass*, AllocatorType>& OutPlayerStates)
+{
+	TCU::Private::AppendRange(GetPlayerStates<UserClass>(ContextObject, bLocalOnly), OutPlayerStates);
+}
+
+template<typename UserClass, typename AllocatorType>
+void UTCU_Library::GetPlayerPawns(const UObject* ContextObject, bool bLocalOnly,
+	TArray<UserClass*, AllocatorType>& OutPlayerPawns)
+{
+	TCU::Private::AppendRange(GetPlayerPawns<UserClass>(ContextObject, bLocalOnly), OutPlayerPawns);
+}
+#pragma endregion
+
 #pragma region Checked
 template<typename UserClass>
 UserClass* UTCU_Library::GetGameMode_Checked(const UObject* ContextObject)
@@ -529,7 +1010,7 @@ UserClass* UTCU_Library::GetWorldSettings_Checked(const UObject* ContextObject)
 template<typename UserClass>
 UserClass* UTCU_Library::GetPlayerController_Checked(const UObject* ContextObject, int32 PlayerIndex)
 {
-	auto* TypedPlayerController = GetPlayerController<UserClass>(ContextObject);
+	auto* TypedPlayerController = GetPlayerController<UserClass>(ContextObject, PlayerIndex);
 	check(IsValid(TypedPlayerController));
 
 	return TypedPlayerController;
@@ -538,7 +1019,7 @@ UserClass* UTCU_Library::GetPlayerController_Checked(const UObject* ContextObjec
 template<typename UserClass>
 UserClass* UTCU_Library::GetLocalPlayer_Checked(const UObject* ContextObject, int32 PlayerIndex)
 {
-	auto* TypedLocalPlayer = GetLocalPlayer<UserClass>(ContextObject);
+	auto* TypedLocalPlayer = GetLocalPlayer<UserClass>(ContextObject, PlayerIndex);
 	check(IsValid(TypedLocalPlayer));
 
 	return TypedLocalPlayer;
@@ -547,8 +1028,8 @@ UserClass* UTCU_Library::GetLocalPlayer_Checked(const UObject* ContextObject, in
 template<typename UserClass>
 UserClass* UTCU_Library::GetModule_Checked(const FName& Name)
 {
-	auto* Module = GetModule(Name);
-	check(IsValid(Module));
+	auto* Module = GetModule<UserClass>(Name);
+	check(Module);
 
 	return Module;
 }
@@ -557,8 +1038,14 @@ UserClass* UTCU_Library::GetModule_Checked(const FName& Name)
 
 #pragma region SaveGame
 template<typename UserClass>
-UserClass* UTCU_Library::CreateSaveGameObject()
+UserClass* UTCU_Library::CreateSaveGameObject(bool bUsePool)
 {
+	if (bUsePool)
+	{
+		USaveGame* SaveGame = UTCU_SaveGamePoolSubsystem::AcquireSaveGame(UserClass::StaticClass());
+		return static_cast<UserClass*>(SaveGame);
+	}
+
 	auto* SaveGame = NewObject<UserClass>(GetTransientPackage(), UserClass::StaticClass());
 	return SaveGame;
 }
@@ -576,6 +1063,27 @@ UserClass* UTCU_Library::LoadGameFromSlot(const FString& SlotName, const int32 U
 	return TypedGameSlot;
 }
 
+template<typename UserClass>
+TFuture<TStrongObjectPtr<UserClass>> UTCU_Library::LoadGameFromSlotAsync(const FString& SlotName)
+{
+	TPromise<TStrongObjectPtr<UserClass>> Promise;
+	TFuture<TStrongObjectPtr<UserClass>> Future = Promise.GetFuture();
+
+	FTCU_SaveGameStorage::LoadGameFromSlotAsync(SlotName, [Promise = MoveTemp(Promise)](USaveGame* SaveGame) mutable
+	{
+		Promise.SetValue(TStrongObjectPtr<UserClass>(Cast<UserClass>(SaveGame)));
+	});
+
+	return Future;
+}
+
+template<typename UserClass>
+UserClass* UTCU_Library::LoadSectionedGameFromSlot(const FString& SlotName)
+{
+	UTCU_SectionedSaveGame* SaveGame = UTCU_SectionedSaveGame::LoadFromSlot(SlotName);
+	return Cast<UserClass>(SaveGame);
+}
+
 template<typename UserClass>
 TArray<TWeakObjectPtr<UserClass>> UTCU_Library::ToWeakObjectPtrArray(const TArray<UserClass*>& Array)
 {
@@ -596,7 +1104,7 @@ TArray<TWeakObjectPtr<const UserClass>> UTCU_Library::ToWeakObjectPtrArray(const
 	TArray<TWeakObjectPtr<const UserClass>> ReturnValue;
 	ReturnValue.Reserve(Array.Num());
 
-	for (UserClass* Element : Array)
+	for (const UserClass* Element : Array)
 	{
 		ReturnValue.Add(Element);
 	}
@@ -610,7 +1118,7 @@ TArray<UserClass*> UTCU_Library::FromWeakObjectPtrArray(const TArray<TWeakObject
 	TArray<UserClass*> ReturnValue;
 	ReturnValue.Reserve(Array.Num());
 
-	for (TWeakObjectPtr<UserClass> Element : Array)
+	for (const TWeakObjectPtr<UserClass>& Element : Array)
 	{
 		ReturnValue.Add(Element.Get());
 	}
@@ -624,7 +1132,7 @@ TArray<const UserClass*> UTCU_Library::FromWeakObjectPtrArray(const TArray<TWeak
 	TArray<const UserClass*> ReturnValue;
 	ReturnValue.Reserve(Array.Num());
 
-	for (TWeakObjectPtr<const UserClass> Element : Array)
+	for (const TWeakObjectPtr<const UserClass>& Element : Array)
 	{
 		ReturnValue.Add(Element.Get());
 	}
@@ -632,6 +1140,95 @@ TArray<const UserClass*> UTCU_Library::FromWeakObjectPtrArray(const TArray<TWeak
 	return ReturnValue;
 }
 
+template<typename UserClass, typename InAllocatorType, typename OutAllocatorType>
+void UTCU_Library::ToWeakObjectPtrArray(const TArray<UserClass*, InAllocatorType>& Array,
+	TArray<TWeakObjectPtr<UserClass>, OutAllocatorType>& OutArray)
+{
+	OutArray.Reserve(OutArray.Num() + Array.Num());
+
+	for (UserClass* Element : Array)
+	{
+		OutArray.Add(Element);
+	}
+}
+
+template<typename UserClass, typename InAllocatorType, typename OutAllocatorType>
+void UTCU_Library::FromWeakObjectPtrArray(const TArray<TWeakObjectPtr<UserClass>, InAllocatorType>& Array,
+	TArray<UserClass*, OutAllocatorType>& OutArray)
+{
+	OutArray.Reserve(OutArray.Num() + Array.Num());
+
+	for (const TWeakObjectPtr<UserClass>& Element : Array)
+	{
+		OutArray.Add(Element.Get());
+	}
+}
+
+template<typename UserClass, typename InAllocatorType, typename OutAllocatorType>
+void UTCU_Library::ResolveWeakObjectPtrs(const TArray<TWeakObjectPtr<UserClass>, InAllocatorType>& Array,
+	TArray<UserClass*, OutAllocatorType>& OutObjects)
+{
+	OutObjects.Reserve(OutObjects.Num() + Array.Num());
+
+	for (const TWeakObjectPtr<UserClass>& Element : Array)
+	{
+		if (UserClass* Object = Element.Get())
+		{
+			OutObjects.Add(Object);
+		}
+	}
+}
+
+template<typename UserClass, typename AllocatorType>
+int32 UTCU_Library::CompactWeakArray(TArray<TWeakObjectPtr<UserClass>, AllocatorType>& Array, bool bStable)
+{
+	const auto IsStale = [](const TWeakObjectPtr<UserClass>& Element)
+	{
+		return !Element.IsValid();
+	};
+
+	return bStable ? Array.RemoveAll(IsStale) : Array.RemoveAllSwap(IsStale, EAllowShrinking::No);
+}
+
+template<typename UserClass, typename InAllocatorType, typename OutAllocatorType>
+void UTCU_Library::ResolveAndCompactWeakArray(TArray<TWeakObjectPtr<UserClass>, InAllocatorType>& Array,
+	TArray<UserClass*, OutAllocatorType>& OutObjects)
+{
+	OutObjects.Reserve(OutObjects.Num() + Array.Num());
+
+	int32 WriteIndex = 0;
+	for (int32 ReadIndex = 0; ReadIndex < Array.Num(); ReadIndex++)
+	{
+		UserClass* Object = Array[ReadIndex].Get();
+		if (!Object)
+		{
+			continue;
+		}
+
+		OutObjects.Add(Object);
+
+		if (WriteIndex != ReadIndex)
+		{
+			Array[WriteIndex] = Array[ReadIndex];
+		}
+
+		WriteIndex++;
+	}
+
+	Array.SetNum(WriteIndex, EAllowShrinking::No);
+}
+
+template<typename UserClass, typename AllocatorType>
+void UTCU_Library::CastArray(TConstArrayView<UObject*> Array, TArray<UserClass*, AllocatorType>& OutArray)
+{
+	OutArray.Reserve(OutArray.Num() + Array.Num());
+
+	TCU::Private::ForEachOfClass(Array, UserClass::StaticClass(), [&OutArray](UObject* Object)
+	{
+		OutArray.Add(static_cast<UserClass*>(Object));
+	});
+}
+
 template<typename UserClass>
 UserClass UTCU_Library::GetArrayElem(const TArray<UserClass>& Array, int32 Index, UserClass ReturnIfEmpty)
 {
@@ -670,8 +1267,25 @@ public:
 	UFUNCTION(BlueprintPure)
 	static float GetMaxWaitingTime();
 
+	UFUNCTION(BlueprintPure)
+	static bool IsActorIndexEnabled();
+
+	UFUNCTION(BlueprintPure)
+	static bool IsActorTagIndexEnabled();
+
 public:
 	/** Max time WaitUntilValid can be active for. Any non-positive value means that there's no limit. */
 	UPROPERTY(Config, EditAnywhere, meta=(Units="seconds"))
 	float MaxWaitingTime = 60.f;
+
+	/** If true, actor queries are answered from the per-world actor index instead of scanning the whole world. */
+	UPROPERTY(Config, EditAnywhere)
+	bool bUseActorIndex = true;
+
+	/**
+	 * If true, actor tag queries are answered from the actor index as well. Only enable it if every tag added to
+	 * AActor::Tags goes through AddActorTag or is reported to the index, as the index doesn't see direct edits.
+	 */
+	UPROPERTY(Config, EditAnywhere, meta=(EditCondition="bUseActorIndex"))
+	bool bUseActorTagIndex = false;
 };
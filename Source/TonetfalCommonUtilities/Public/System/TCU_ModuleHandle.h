@@ -0,0 +1,67 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#pragma once
+
+#include "Delegates/IDelegateInstance.h"
+#include "Modules/ModuleInterface.h"
+
+#include <atomic>
+
+/**
+ * Cached lookup of a module interface. The module is looked up in FModuleManager, which takes its lock and searches its
+ * map, only until it's found; afterwards getting it is a single atomic load. The cache is dropped when the module is
+ * unloaded, so that a reloaded module is looked up again. Meant to be kept in a static, e.g.
+ *
+ *	static TTCU_ModuleHandle<FMyModule> MyModule(TEXT("MyModule"));
+ *
+ * Modules are loaded and unloaded on the game thread, so the cache is only filled there, along with registering the
+ * handler that drops it; other threads use it once it is, and look the module up without caching it otherwise. A
+ * pointer obtained off the game thread is only valid for as long as the module is known to stay loaded, same as the
+ * one returned by FModuleManager.
+ */
+class TONETFALCOMMONUTILITIES_API FTCU_ModuleHandle
+{
+public:
+	explicit FTCU_ModuleHandle(FName InModuleName);
+	~FTCU_ModuleHandle();
+
+	FTCU_ModuleHandle(const FTCU_ModuleHandle&) = delete;
+	FTCU_ModuleHandle& operator=(const FTCU_ModuleHandle&) = delete;
+
+	/** Returns the module, or null if it isn't loaded. */
+	[[nodiscard]] IModuleInterface* Get() const;
+
+	[[nodiscard]] FName GetModuleName() const;
+
+private:
+	FName ModuleName;
+
+	/** Shared with the module change handler, which may outlive the handle. */
+	TSharedRef<std::atomic<IModuleInterface*>> CachedModule;
+
+	/** Handler of FModuleManager::OnModulesChanged. Registered on the game thread before the cache is first filled. */
+	mutable FDelegateHandle ModulesChangedHandle;
+};
+
+template<typename ModuleType>
+class TTCU_ModuleHandle
+	: public FTCU_ModuleHandle
+{
+public:
+	using FTCU_ModuleHandle::FTCU_ModuleHandle;
+
+	/** Returns the module, or null if it isn't loaded. */
+	[[nodiscard]] ModuleType* Get() const
+	{
+		return static_cast<ModuleType*>(FTCU_ModuleHandle::Get());
+	}
+
+	/** Returns the module, asserting that it's loaded. */
+	[[nodiscard]] ModuleType& GetChecked() const
+	{
+		ModuleType* Module = Get();
+		check(Module);
+
+		return *Module;
+	}
+};
@@ -0,0 +1,294 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#pragma once
+
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "System/TCU_Casts.h"
+
+/**
+ * Lightweight views over the players of a world. They don't own or allocate anything, and filter lazily while being
+ * iterated, so they're meant to be consumed right away with a range-based for loop:
+ *
+ *	for (AMyPlayerController* PlayerController : UTCU_Library::GetPlayerControllers<AMyPlayerController>(this))
+ *
+ * Elements are filtered by UserClass, and optionally by a runtime class that must be a child of UserClass.
+ */
+namespace TCU::Private
+{
+	template<typename UserClass, typename BaseClass>
+	bool MatchesClass(const BaseClass* Object, const UClass* Class)
+	{
+		if (Class)
+		{
+			return Object->IsA(Class);
+		}
+
+		return IsOfClass<UserClass>(Object);
+	}
+
+	inline bool IsLocalPlayerState(const APlayerState* PlayerState)
+	{
+		const APlayerController* PlayerController = PlayerState->GetPlayerController();
+		return IsValid(PlayerController) && PlayerController->IsLocalController();
+	}
+
+	template<typename RangeType, typename ElementType, typename AllocatorType>
+	void AppendRange(const RangeType& Range, TArray<ElementType, AllocatorType>& OutArray)
+	{
+		OutArray.Reserve(OutArray.Num() + Range.MaxNum());
+		for (ElementType Element : Range)
+		{
+			OutArray.Add(Element);
+		}
+	}
+}
+
+struct FTCU_PlayerRangeEnd
+{
+};
+
+template<typename UserClass = APlayerController>
+class TTCU_PlayerControllerRange
+{
+public:
+	class FIterator
+	{
+	public:
+		FIterator(const TTCU_PlayerControllerRange& InRange, FConstPlayerControllerIterator InIterator)
+			: Range(InRange)
+			, Iterator(MoveTemp(InIterator))
+		{
+			SkipFilteredOut();
+		}
+
+		UserClass* operator*() const
+		{
+			return static_cast<UserClass*>(Iterator->Get());
+		}
+
+		FIterator& operator++()
+		{
+			++Iterator;
+			SkipFilteredOut();
+			return *this;
+		}
+
+		bool operator!=(FTCU_PlayerRangeEnd) const
+		{
+			return !!Iterator;
+		}
+
+	private:
+		void SkipFilteredOut()
+		{
+			for (; Iterator; ++Iterator)
+			{
+				const APlayerController* PlayerController = Iterator->Get();
+				if (IsValid(PlayerController) && Range.Matches(PlayerController))
+				{
+					break;
+				}
+			}
+		}
+
+	private:
+		const TTCU_PlayerControllerRange& Range;
+		FConstPlayerControllerIterator Iterator;
+	};
+
+public:
+	TTCU_PlayerControllerRange(const UWorld* InWorld, bool bInLocalOnly, const UClass* InClass = nullptr)
+		: World(InWorld)
+		, Class(InClass)
+		, bLocalOnly(bInLocalOnly)
+	{
+	}
+
+	/** Upper bound of the number of elements this range can produce. */
+	int32 MaxNum() const
+	{
+		return IsValid(World) ? World->GetNumPlayerControllers() : 0;
+	}
+
+	FIterator begin() const
+	{
+		static const TArray<TWeakObjectPtr<APlayerController>> EmptyArray;
+		return FIterator(*this, IsValid(World)
+			? World->GetPlayerControllerIterator()
+			: EmptyArray.CreateConstIterator());
+	}
+
+	FTCU_PlayerRangeEnd end() const
+	{
+		return {};
+	}
+
+private:
+	bool Matches(const APlayerController* PlayerController) const
+	{
+		if (bLocalOnly && !PlayerController->IsLocalController())
+		{
+			return false;
+		}
+
+		return TCU::Private::MatchesClass<UserClass>(PlayerController, Class);
+	}
+
+private:
+	const UWorld* World = nullptr;
+	const UClass* Class = nullptr;
+	bool bLocalOnly = false;
+};
+
+/** Base of ranges that walk through AGameStateBase::PlayerArray. */
+template<typename UserClass, typename DerivedType>
+class TTCU_PlayerArrayRange
+{
+public:
+	class FIterator
+	{
+	public:
+		FIterator(const DerivedType& InRange, int32 InIndex)
+			: Range(InRange)
+			, Index(InIndex)
+		{
+			SkipFilteredOut();
+		}
+
+		UserClass* operator*() const
+		{
+			return Range.Project(Range.GetPlayerArray()[Index]);
+		}
+
+		FIterator& operator++()
+		{
+			++Index;
+			SkipFilteredOut();
+			return *this;
+		}
+
+		bool operator!=(FTCU_PlayerRangeEnd) const
+		{
+			return Index < Range.GetPlayerArray().Num();
+		}
+
+	private:
+		void SkipFilteredOut()
+		{
+			const TArray<TObjectPtr<APlayerState>>& PlayerArray = Range.GetPlayerArray();
+			for (; Index < PlayerArray.Num(); ++Index)
+			{
+				const APlayerState* PlayerState = PlayerArray[Index];
+				if (IsValid(PlayerState) && Range.Matches(PlayerState))
+				{
+					break;
+				}
+			}
+		}
+
+	private:
+		const DerivedType& Range;
+		int32 Index = 0;
+	};
+
+public:
+	TTCU_PlayerArrayRange(const UWorld* InWorld, bool bInLocalOnly, const UClass* InClass)
+		: GameState(IsValid(InWorld) ? InWorld->GetGameState() : nullptr)
+		, Class(InClass)
+		, bLocalOnly(bInLocalOnly)
+	{
+	}
+
+	/** Upper bound of the number of elements this range can produce. */
+	int32 MaxNum() const
+	{
+		return GetPlayerArray().Num();
+	}
+
+	FIterator begin() const
+	{
+		return FIterator(static_cast<const DerivedType&>(*this), 0);
+	}
+
+	FTCU_PlayerRangeEnd end() const
+	{
+		return {};
+	}
+
+protected:
+	const TArray<TObjectPtr<APlayerState>>& GetPlayerArray() const
+	{
+		static const TArray<TObjectPtr<APlayerState>> EmptyArray;
+		return IsValid(GameState) ? GameState->PlayerArray : EmptyArray;
+	}
+
+	bool PassesLocalFilter(const APlayerState* PlayerState) const
+	{
+		return !bLocalOnly || TCU::Private::IsLocalPlayerState(PlayerState);
+	}
+
+protected:
+	const AGameStateBase* GameState = nullptr;
+	const UClass* Class = nullptr;
+	bool bLocalOnly = false;
+};
+
+template<typename UserClass = APlayerState>
+class TTCU_PlayerStateRange
+	: public TTCU_PlayerArrayRange<UserClass, TTCU_PlayerStateRange<UserClass>>
+{
+	using Super = TTCU_PlayerArrayRange<UserClass, TTCU_PlayerStateRange>;
+	friend Super;
+
+public:
+	TTCU_PlayerStateRange(const UWorld* InWorld, bool bInLocalOnly, const UClass* InClass = nullptr)
+		: Super(InWorld, bInLocalOnly, InClass)
+	{
+	}
+
+private:
+	bool Matches(const APlayerState* PlayerState) const
+	{
+		return Super::PassesLocalFilter(PlayerState) &&
+			TCU::Private::MatchesClass<UserClass>(PlayerState, Super::Class);
+	}
+
+	static UserClass* Project(APlayerState* PlayerState)
+	{
+		return static_cast<UserClass*>(PlayerState);
+	}
+};
+
+template<typename UserClass = APawn>
+class TTCU_PlayerPawnRange
+	: public TTCU_PlayerArrayRange<UserClass, TTCU_PlayerPawnRange<UserClass>>
+{
+	using Super = TTCU_PlayerArrayRange<UserClass, TTCU_PlayerPawnRange>;
+	friend Super;
+
+public:
+	TTCU_PlayerPawnRange(const UWorld* InWorld, bool bInLocalOnly, const UClass* InClass = nullptr)
+		: Super(InWorld, bInLocalOnly, InClass)
+	{
+	}
+
+private:
+	bool Matches(const APlayerState* PlayerState) const
+	{
+		if (!Super::PassesLocalFilter(PlayerState))
+		{
+			return false;
+		}
+
+		const APawn* Pawn = PlayerState->GetPawn();
+		return IsValid(Pawn) && TCU::Private::MatchesClass<UserClass>(Pawn, Super::Class);
+	}
+
+	static UserClass* Project(const APlayerState* PlayerState)
+	{
+		return static_cast<UserClass*>(PlayerState->GetPawn());
+	}
+};
@@ -0,0 +1,116 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#pragma once
+
+#include "GameFramework/OnlineReplStructs.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+
+#include "TCU_PlayerRosterSubsystem.generated.h"
+
+class AGameModeBase;
+class APlayerState;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FTCU_PlayerRosterEntrySignature, APlayerState* /*PlayerState*/);
+DECLARE_MULTICAST_DELEGATE(FTCU_PlayerRosterSignature);
+
+/**
+ * Per-world cache of the players listed in AGameStateBase::PlayerArray, along with their controller, pawn, local flag
+ * and net ID, laid out as a structure of arrays.
+ *
+ * The roster is marked dirty on login/logout, player controller/state spawn and destruction, and possession changes,
+ * and is refreshed lazily on the next read. Once per frame, the entries are compared with their player states to catch
+ * replicated changes the engine doesn't notify about (e.g. the owner of a player state arriving on a client), which
+ * doesn't rebuild anything unless a difference is found. Entry delegates are broadcast whenever a refresh detects one.
+ */
+UCLASS()
+class TONETFALCOMMONUTILITIES_API UTCU_PlayerRosterSubsystem
+	: public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Returns the roster of the world the context object belongs to, or null if the world doesn't have one. */
+	static UTCU_PlayerRosterSubsystem* Get(const UObject* ContextObject);
+
+	//~UWorldSubsystem Interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of UWorldSubsystem Interface
+
+	//~FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~End of FTickableGameObject Interface
+
+	/** Marks the roster as outdated. Use it when changing something the roster can't be notified about. */
+	void MarkDirty();
+
+	int32 GetPlayersNum(bool bLocalOnly = false);
+
+	TConstArrayView<TWeakObjectPtr<APlayerState>> GetPlayerStates();
+	TConstArrayView<TWeakObjectPtr<APlayerController>> GetControllers();
+	TConstArrayView<TWeakObjectPtr<APawn>> GetPawns();
+	TConstArrayView<FUniqueNetIdRepl> GetNetIds();
+	const TBitArray<>& GetLocalFlags();
+
+	/** Returns the player pawns that are of the given class. The list is cached until the roster changes. */
+	TConstArrayView<APawn*> GetPawnsOfClass(const UClass* Class, bool bLocalOnly = false);
+
+	/** Returns the player states that are of the given class. The list is cached until the roster changes. */
+	TConstArrayView<APlayerState*> GetPlayerStatesOfClass(const UClass* Class, bool bLocalOnly = false);
+
+protected:
+	//~UWorldSubsystem Interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~End of UWorldSubsystem Interface
+
+private:
+	void RefreshIfDirty();
+	void Refresh();
+
+	/** Returns whether anything the roster isn't notified about differs from the cached entries. */
+	bool HasUnnotifiedChanges() const;
+
+	void OnActorSpawned(AActor* Actor);
+	void OnActorDestroyed(AActor* Actor);
+	void OnPostLogin(AGameModeBase* GameMode, APlayerController* NewPlayer);
+	void OnLogout(AGameModeBase* GameMode, AController* Exiting);
+
+	UFUNCTION()
+	void OnPlayerStatePawnSet(APlayerState* PlayerState, APawn* NewPawn, APawn* OldPawn);
+
+public:
+	FTCU_PlayerRosterEntrySignature OnPlayerAdded;
+	FTCU_PlayerRosterEntrySignature OnPlayerRemoved;
+
+	/** Broadcast when controller, pawn, local flag or net ID of an already listed player changes. */
+	FTCU_PlayerRosterEntrySignature OnPlayerChanged;
+
+	/** Broadcast once after a refresh that changed anything, after the entry delegates. */
+	FTCU_PlayerRosterSignature OnRosterChanged;
+
+private:
+	using FClassFilterKey = TPair<TObjectKey<UClass>, bool>;
+
+	TArray<TWeakObjectPtr<APlayerState>> PlayerStates;
+	TArray<TWeakObjectPtr<APlayerController>> Controllers;
+	TArray<TWeakObjectPtr<APawn>> Pawns;
+	TArray<FUniqueNetIdRepl> NetIds;
+	TBitArray<> LocalFlags;
+	int32 LocalPlayersNum = 0;
+
+	/** Index of the entry of each listed player state. */
+	TMap<TObjectKey<APlayerState>, int32> PlayerIndices;
+
+	/** Filtered lists handed out by GetPawnsOfClass/GetPlayerStatesOfClass. Cleared whenever the roster changes. */
+	TMap<FClassFilterKey, TArray<APawn*>> PawnsOfClass;
+	TMap<FClassFilterKey, TArray<APlayerState*>> PlayerStatesOfClass;
+
+	bool bDirty = true;
+
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle ActorDestroyedHandle;
+	FDelegateHandle PostLoginHandle;
+	FDelegateHandle LogoutHandle;
+};
@@ -0,0 +1,155 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "WorldCollision.h"
+
+#include "TCU_PlayerStartSubsystem.generated.h"
+
+class APlayerStart;
+
+DECLARE_DELEGATE_OneParam(FTCU_OnPlayerStartsFound, const TArray<APlayerStart*>& /*PlayerStarts*/);
+
+enum class ETCU_PlayerStartOccupancy : uint8
+{
+	/** Pawn can be spawned right at the player start. */
+	Free,
+
+	/** Pawn doesn't fit as is, but there's a teleport spot nearby. */
+	Occupied,
+
+	/** Pawn can't be spawned at the player start at all. */
+	Blocked,
+};
+
+/**
+ * Per-world cache of player starts, bucketed by their PlayerStartTag, used to pick spawn points for many players at
+ * once. Occupancy of each player start is evaluated at most once per frame and pawn class, and starts that are handed
+ * out are considered occupied for the rest of the frame, so that consecutive requests don't stack players up.
+ */
+UCLASS()
+class TONETFALCOMMONUTILITIES_API UTCU_PlayerStartSubsystem
+	: public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Returns the subsystem of the world the context object belongs to, or null if the world doesn't have one. */
+	static UTCU_PlayerStartSubsystem* Get(const UObject* ContextObject);
+
+	//~UWorldSubsystem Interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of UWorldSubsystem Interface
+
+	/**
+	 * Picks player starts for a number of players at once. Each requester gets a distinct player start for as long as
+	 * there are enough of them, free ones first, then occupied ones that have a teleport spot nearby. If there's a
+	 * "Play from Here" player start, everyone gets it.
+	 * @param	RequestsNum Number of player starts to pick.
+	 * @param	IncomingName If not empty, player starts with a matching tag are preferred.
+	 * @param	PawnClass Class of the pawns that will be spawned. Used to check whether they fit.
+	 * @param	OutPlayerStarts Picked player starts, one per request. Null if there was nothing to pick.
+	 */
+	void FindPlayerStarts(int32 RequestsNum, const FString& IncomingName, TSubclassOf<APawn> PawnClass,
+		TArray<APlayerStart*>& OutPlayerStarts);
+
+	/**
+	 * Asynchronous version of FindPlayerStarts. Occupancy checks are issued as async overlap queries, so the callback
+	 * fires once physics has processed them, usually during the next frame. The selection policy is the same. If the
+	 * pawn has no collision to test, the callback fires right away.
+	 */
+	void FindPlayerStartsAsync(int32 RequestsNum, const FString& IncomingName, TSubclassOf<APawn> PawnClass,
+		FTCU_OnPlayerStartsFound OnFound);
+
+	/**
+	 * Spreads player starts found for the valid controllers over the whole array of controllers. Invalid ones get null.
+	 */
+	static void SpreadOverControllers(TConstArrayView<APlayerController*> Controllers,
+		TConstArrayView<APlayerStart*> FoundPlayerStarts, TArray<APlayerStart*>& OutPlayerStarts);
+
+	/** Returns the occupancy of a player start for the given pawn class, evaluating it if it's not known this frame. */
+	ETCU_PlayerStartOccupancy GetOccupancy(APlayerStart* PlayerStart, TSubclassOf<APawn> PawnClass);
+
+	/** Returns all the cached player starts. */
+	TConstArrayView<TWeakObjectPtr<APlayerStart>> GetPlayerStarts();
+
+	/** Returns the cached player starts that have a given tag. */
+	TConstArrayView<TWeakObjectPtr<APlayerStart>> GetPlayerStartsWithTag(FName Tag);
+
+	/** Returns the "Play from Here" player start if there's one. */
+	APlayerStart* GetPIEPlayerStart();
+
+	/** Marks the player start as taken for the rest of the frame. */
+	void ClaimPlayerStart(APlayerStart* PlayerStart);
+
+	/**
+	 * Distributes player starts among a number of requesters. Tagged starts are handed out first, then free ones, and
+	 * then occupied ones, each time in random order and without giving the same start twice. Once all of them are
+	 * taken, remaining requesters get a random free or occupied start.
+	 */
+	static void AssignPlayerStarts(int32 RequestsNum, APlayerStart* PIEStart,
+		TArray<APlayerStart*> TaggedStarts, TArray<APlayerStart*> FreeStarts, TArray<APlayerStart*> OccupiedStarts,
+		TArray<APlayerStart*>& OutPlayerStarts);
+
+private:
+	void RebuildIfDirty();
+	void ResetOccupancyIfOutdated();
+	ETCU_PlayerStartOccupancy EvaluateOccupancy(const APlayerStart* PlayerStart, const APawn* PawnToFit,
+		bool bNeedTeleportCheck);
+
+	void OnAsyncOverlapCompleted(const FTraceHandle& TraceHandle, FOverlapDatum& OverlapDatum, int32 RequestId,
+		int32 CandidateIndex);
+	void CompleteAsyncRequest(int32 RequestId);
+
+	void OnActorSpawned(AActor* Actor);
+	void OnActorDestroyed(AActor* Actor);
+	void OnLevelChanged(ULevel* Level, UWorld* World);
+
+private:
+	enum class EOccupancyCheck : uint8
+	{
+		/** Pawn doesn't fit, but whether there's a teleport spot nearby hasn't been checked yet. */
+		Encroached,
+		Free,
+		Occupied,
+		Blocked,
+	};
+
+	using FOccupancyKey = TPair<TObjectKey<APlayerStart>, TObjectKey<UClass>>;
+
+	struct FAsyncCandidate
+	{
+		TWeakObjectPtr<APlayerStart> PlayerStart;
+		bool bTagged = false;
+		bool bFree = false;
+	};
+
+	struct FAsyncRequest
+	{
+		int32 RequestsNum = 0;
+		TWeakObjectPtr<UClass> PawnClass;
+		TArray<FAsyncCandidate> Candidates;
+		int32 PendingChecksNum = 0;
+		FTCU_OnPlayerStartsFound OnFound;
+	};
+
+	TArray<TWeakObjectPtr<APlayerStart>> PlayerStarts;
+	TMap<FName, TArray<TWeakObjectPtr<APlayerStart>>> PlayerStartsByTag;
+	TWeakObjectPtr<APlayerStart> PIEPlayerStart;
+	bool bDirty = true;
+
+	TMap<FOccupancyKey, EOccupancyCheck> Occupancy;
+	TSet<TObjectKey<APlayerStart>> ClaimedPlayerStarts;
+	uint64 OccupancyFrame = 0;
+
+	TMap<int32, FAsyncRequest> AsyncRequests;
+	int32 NextAsyncRequestId = 0;
+
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle ActorDestroyedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+};
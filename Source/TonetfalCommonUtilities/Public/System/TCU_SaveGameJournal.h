@@ -0,0 +1,82 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#pragma once
+
+#include "System/TCU_SaveGameStorage.h"
+
+#include <atomic>
+
+/**
+ * Incremental saves of a slot of FTCU_SaveGameStorage. A commit only appends the properties that have changed since
+ * the previous one to a journal next to the slot, while the whole object is only written, as the slot itself, once the
+ * journal grows past its limits. Loading the slot replays the journal on top of it.
+ *
+ * Properties are compared by the hash of their serialized values, and what's been committed is only known for the
+ * lifetime of the journal, so its first commit writes the whole object. Serialization happens on the game thread,
+ * while compression and writing are done by the storage in the background, in the order commits have been made in.
+ *
+ * Saving the slot by other means, e.g. FTCU_SaveGameStorage::SaveGameToSlotAsync, replaces what the journal has been
+ * written on top of. Commits made afterwards fail, and the next one compacts the journal again.
+ */
+class TONETFALCOMMONUTILITIES_API FTCU_SaveGameJournal
+{
+public:
+	explicit FTCU_SaveGameJournal(const FString& InSlotName,
+		ETCU_SaveGameCompression InCompression = ETCU_SaveGameCompression::Oodle);
+
+	/**
+	 * Serializes the properties that have changed since the last commit right away, and appends them to the journal in
+	 * the background. Compacts the journal instead if it's grown past its limits. Must be called from the game thread.
+	 * @return	Future that is fulfilled by a worker thread with whether the changes have been written.
+	 */
+	TFuture<bool> Commit(USaveGame* SaveGame);
+
+	/**
+	 * Serializes the whole object right away, and writes it to the slot in the background, clearing the journal. Must
+	 * be called from the game thread.
+	 * @return	Future that is fulfilled by a worker thread with whether the slot has been written.
+	 */
+	TFuture<bool> Compact(USaveGame* SaveGame);
+
+	const FString& GetSlotName() const;
+
+	static FString GetJournalPath(const FString& SlotName);
+
+	/**
+	 * Reads and unpacks the records of a journal, as long as it's been written on top of the slot data with the given
+	 * CRC. Records from the first corrupted one on, such as the one that's been partially appended, are dropped.
+	 */
+	static bool ReadJournal(const FString& Path, uint32 SlotDataCrc, TArray<TArray<uint8>>& OutRecords);
+
+	/** Applies an unpacked record to the object. Must be called from the game thread. */
+	static bool ApplyRecord(USaveGame* SaveGame, TConstArrayView<uint8> Record);
+
+public:
+	/** Number of records after which the journal is compacted. */
+	int32 MaxRecordsNum = 64;
+
+	/** Uncompressed size of the journal relative to the one of the slot after which the journal is compacted. */
+	double MaxSizeRatio = 1.0;
+
+private:
+	bool ShouldCompact(const USaveGame* SaveGame) const;
+
+private:
+	FString SlotName;
+	ETCU_SaveGameCompression Compression;
+
+	/** Hashes of the serialized values of the properties as of the last commit. */
+	TMap<FName, uint64> CommittedHashes;
+	TWeakObjectPtr<UClass> CommittedClass;
+
+	int32 RecordsNum = 0;
+	int64 JournalSize = 0;
+	int64 SlotSize = 0;
+
+	/** CRC of the slot data the journal has been compacted on, which the journal file is checked against on commits. */
+	uint32 SlotDataCrc = 0;
+	bool bCompacted = false;
+
+	/** Set by the worker when a write fails, as the committed state doesn't match the one on the disk anymore. */
+	TSharedRef<std::atomic<bool>> WriteFailedFlag;
+};
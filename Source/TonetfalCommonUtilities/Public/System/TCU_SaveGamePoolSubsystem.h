@@ -0,0 +1,71 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#pragma once
+
+#include "Subsystems/EngineSubsystem.h"
+#include "Templates/SubclassOf.h"
+
+#include "TCU_SaveGamePoolSubsystem.generated.h"
+
+class USaveGame;
+
+USTRUCT()
+struct FTCU_SaveGamePool
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+	TArray<TObjectPtr<USaveGame>> Objects;
+
+	/** Whether objects of the class can be reset by copying the class defaults over them. */
+	bool bCanBePooled = false;
+};
+
+/**
+ * Pool of save game objects, for systems that create and throw them away often, such as snapshots, so that they don't
+ * put pressure on the garbage collector. Released objects are reset to the defaults of their class right away. Classes
+ * whose objects can't be reset by copying the class defaults, such as the ones with instanced subobjects, aren't
+ * pooled, and their objects are simply created anew.
+ */
+UCLASS()
+class TONETFALCOMMONUTILITIES_API UTCU_SaveGamePoolSubsystem
+	: public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UTCU_SaveGamePoolSubsystem* Get();
+
+	/**
+	 * Returns a pooled object of the class, or creates one if there are none. Falls back to NewObject without a pool.
+	 */
+	static USaveGame* AcquireSaveGame(TSubclassOf<USaveGame> Class);
+
+	/** Returns the object to the pool. It must not be used anymore. Does nothing without a pool. */
+	static void ReleaseSaveGame(USaveGame* SaveGame);
+
+	//~USubsystem Interface
+	virtual void Deinitialize() override;
+	//~End of USubsystem Interface
+
+	USaveGame* Acquire(TSubclassOf<USaveGame> Class);
+	void Release(USaveGame* SaveGame);
+
+	/** Lets all of the pooled objects be garbage collected. */
+	void Trim();
+
+private:
+	FTCU_SaveGamePool& GetPool(UClass* Class);
+
+	static bool CanBePooled(const UClass* Class);
+	static void ResetToDefaults(USaveGame* SaveGame);
+
+public:
+	/** Objects released past this number for a single class are left to be garbage collected. */
+	int32 MaxPooledObjectsPerClass = 16;
+
+private:
+	UPROPERTY()
+	TMap<TObjectPtr<UClass>, FTCU_SaveGamePool> Pools;
+};
@@ -0,0 +1,67 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#pragma once
+
+#include "Async/Future.h"
+#include "CoreMinimal.h"
+
+#include "TCU_SaveGameStorage.generated.h"
+
+class USaveGame;
+
+UENUM(BlueprintType)
+enum class ETCU_SaveGameCompression : uint8
+{
+	None,
+	Zlib,
+	Oodle,
+};
+
+/**
+ * Save slots that are compressed, written and read by a worker thread. Only serialization of the saved objects and
+ * creation of the loaded ones happen on the game thread. Slots are written to a temporary file that then replaces the
+ * slot, so they're never left partially written, and requests are carried out in the order they've been made in, so
+ * a slot loaded right after being saved is read back the way it's been saved.
+ *
+ * Slots are files in the SaveGames directory of the project, and aren't compatible with UGameplayStatics save slots.
+ * Loading a slot also replays its journal on top of it, if it has one; see FTCU_SaveGameJournal.
+ */
+class TONETFALCOMMONUTILITIES_API FTCU_SaveGameStorage
+{
+public:
+	/**
+	 * Serializes the object right away, and writes it in the background. Must be called from the game thread.
+	 * @return	Future that is fulfilled by a worker thread with whether the slot has been written.
+	 */
+	static TFuture<bool> SaveGameToSlotAsync(USaveGame* SaveGame, const FString& SlotName,
+		ETCU_SaveGameCompression Compression = ETCU_SaveGameCompression::Oodle);
+
+	/** Reads the slot in the background, and calls the callback on the game thread with the loaded object or null. */
+	static void LoadGameFromSlotAsync(const FString& SlotName, TUniqueFunction<void(USaveGame*)>&& OnLoaded);
+
+	/**
+	 * Carries the request out on a worker thread once the ones made before it are done.
+	 * @return	Future that is fulfilled by a worker thread with the result of the request.
+	 */
+	static TFuture<bool> Enqueue(const TCHAR* DebugName, TUniqueFunction<bool()>&& Request);
+
+	/** Blocks until all of the requests made so far are carried out. */
+	static void Flush();
+
+	static FString GetSlotPath(const FString& SlotName);
+
+	/** Packs the data into the slot format. Fails for data larger than 256 MB. */
+	static bool Encode(TConstArrayView<uint8> Data, ETCU_SaveGameCompression Compression, TArray<uint8>& OutSlotData);
+
+	/** Unpacks the data from the slot format. Rejects slots that claim to hold more than 256 MB. */
+	static bool Decode(TConstArrayView<uint8> SlotData, TArray<uint8>& OutData);
+
+	/** Writes the file through a temporary one, so that it's never left partially written. */
+	static bool WriteFileAtomically(const FString& Path, TConstArrayView<uint8> Data);
+
+	/**
+	 * Reads and unpacks the slot file. Falls back to the temporary file when the slot is missing, as it's the case when
+	 * replacing it has been interrupted.
+	 */
+	static bool ReadSlotFile(const FString& Path, TArray<uint8>& OutData);
+};
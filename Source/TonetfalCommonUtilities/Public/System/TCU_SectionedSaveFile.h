@@ -0,0 +1,68 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#pragma once
+
+#include "System/TCU_SaveGameStorage.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Save file split into sections that are packed separately, so that any of them can be read without touching the
+ * others. The file is memory-mapped where the platform supports it, so only the pages of the sections that are actually
+ * read are loaded from the disk; elsewhere it's read into memory as a whole.
+ */
+class TONETFALCOMMONUTILITIES_API FTCU_SectionedSaveFile
+{
+public:
+	struct FSection
+	{
+		FName Name;
+
+		/** Describes the data, so that it can be told apart from the one that's been saved by older versions. */
+		FString Type;
+
+		TArray<uint8> Data;
+	};
+
+public:
+	~FTCU_SectionedSaveFile();
+
+	/** Opens the file and reads its section table. Returns null if it doesn't exist or isn't a sectioned save file. */
+	static TSharedPtr<FTCU_SectionedSaveFile> Open(const FString& Path);
+
+	/** Packs the sections into the file format. Safe to call from any thread. */
+	static bool Encode(const FString& ClassPath, TConstArrayView<FSection> Sections,
+		ETCU_SaveGameCompression Compression, TArray<uint8>& OutFileData);
+
+	/** Returns the path of the class of the object that has been saved. */
+	const FString& GetClassPath() const;
+
+	bool HasSection(FName Name) const;
+	int32 GetSectionsNum() const;
+
+	/** Unpacks the section, if it exists and is of the given type. */
+	bool ReadSection(FName Name, const FString& Type, TArray<uint8>& OutData) const;
+
+private:
+	struct FSectionEntry
+	{
+		FString Type;
+		int64 Offset = 0;
+		int64 Size = 0;
+	};
+
+	bool ReadSectionTable();
+
+private:
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	/** Contents of the file when it can't be mapped. */
+	TArray<uint8> FileData;
+
+	TConstArrayView<uint8> Data;
+
+	FString ClassPath;
+	TMap<FName, FSectionEntry> Sections;
+};
@@ -0,0 +1,94 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#pragma once
+
+#include "GameFramework/SaveGame.h"
+#include "System/TCU_SaveGameStorage.h"
+
+#include "TCU_SectionedSaveGame.generated.h"
+
+class FTCU_SectionedSaveFile;
+
+/**
+ * Save game whose properties are saved as separate sections of a memory-mapped file, and are only deserialized once
+ * they're accessed, so loading it only costs as much as the sections that are actually used. Sections are accessed
+ * through typed accessors of the subclasses:
+ *
+ *	FMyInventory& GetInventory() { return GetSection<FMyInventory>(GET_MEMBER_NAME_CHECKED(ThisClass, Inventory)); }
+ *
+ * Sections whose type has changed since they've been saved are left with their default values. The properties must
+ * not be accessed directly, as they may not have been loaded yet.
+ */
+UCLASS(Abstract)
+class TONETFALCOMMONUTILITIES_API UTCU_SectionedSaveGame
+	: public USaveGame
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Opens the slot without deserializing any of its sections. Waits for the pending requests of
+	 * FTCU_SaveGameStorage, as they may write the slot. Must be called from the game thread.
+	 */
+	static UTCU_SectionedSaveGame* LoadFromSlot(const FString& SlotName);
+
+	static FString GetSlotPath(const FString& SlotName);
+
+	/**
+	 * Serializes the sections right away, and compresses and writes them in the background. Sections that haven't been
+	 * loaded yet are loaded first. Must be called from the game thread.
+	 * @return	Future that is fulfilled by a worker thread with whether the slot has been written.
+	 */
+	TFuture<bool> SaveToSlotAsync(const FString& SlotName,
+		ETCU_SaveGameCompression Compression = ETCU_SaveGameCompression::Oodle);
+
+	/**
+	 * Returns the section, deserializing it first if it hasn't been yet. Struct sections must be of exactly the given
+	 * struct; other types are only checked for their size.
+	 */
+	template<typename SectionType>
+	SectionType& GetSection(FName SectionName);
+
+	/**
+	 * Deserializes the section if it hasn't been yet.
+	 * @return	False if the section is missing from the slot or can't be read, leaving it with its default value.
+	 */
+	bool LoadSection(FName SectionName);
+
+	/** Deserializes all of the sections that haven't been yet, and closes the slot file. */
+	void LoadAllSections();
+
+	bool IsSectionLoaded(FName SectionName) const;
+
+private:
+	bool LoadSection(FProperty* Property);
+
+private:
+	/** File the sections that haven't been accessed yet are read from. */
+	TSharedPtr<FTCU_SectionedSaveFile> SourceFile;
+
+	TSet<FName> LoadedSections;
+};
+
+template<typename SectionType>
+SectionType& UTCU_SectionedSaveGame::GetSection(FName SectionName)
+{
+	FProperty* Property = FindFProperty<FProperty>(GetClass(), SectionName);
+	check(Property);
+
+	// A property of another type with the same size would otherwise be reinterpreted as the section
+	if constexpr (TModels_V<CStaticStructProvider, SectionType>)
+	{
+		const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+		checkf(StructProperty && StructProperty->Struct == SectionType::StaticStruct(),
+			TEXT("Save game section [%s] isn't of type %s"), *SectionName.ToString(),
+			*SectionType::StaticStruct()->GetName());
+	}
+	else
+	{
+		check(Property->GetElementSize() == sizeof(SectionType));
+	}
+
+	LoadSection(Property);
+	return *Property->ContainerPtrToValuePtr<SectionType>(this);
+}
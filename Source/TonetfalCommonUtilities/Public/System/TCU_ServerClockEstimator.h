@@ -0,0 +1,70 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Estimates the offset between the local clock and the server one from timestamps the server sends.
+ *
+ * Out of a window of the most recent samples, the timestamp that has been delayed the least is trusted the most, as
+ * it's the least affected by queuing delays, and is compensated by half of the lowest round trip time in the window.
+ * The offset that is actually applied doesn't jump to a new estimate, but slews towards it at a limited rate, so the
+ * resulting server time keeps moving forward smoothly. Large errors, such as the very first estimate, are applied at
+ * once. The returned time never goes backwards; if the offset has to be snapped back, the time stands still until it
+ * catches up.
+ */
+class TONETFALCOMMONUTILITIES_API FTCU_ServerClockEstimator
+{
+public:
+	/**
+	 * Adds a sample.
+	 * @param	LocalTime Local time the server timestamp has been received at.
+	 * @param	ServerTime Server time the timestamp has been sent at.
+	 * @param	RoundTripTime Current round trip time to the server, in seconds.
+	 */
+	void AddSample(double LocalTime, double ServerTime, double RoundTripTime);
+
+	/** Moves the applied offset towards the estimated one. Meant to be called once per frame. */
+	void Advance(double LocalTime);
+
+	/** Returns the smoothed server time at the given local time. */
+	double GetServerTime(double LocalTime) const;
+
+	bool HasSamples() const;
+
+	/** Returns the offset that is currently applied to the local time. */
+	double GetOffset() const;
+
+	/** Returns the offset the applied one is slewing towards. */
+	double GetTargetOffset() const;
+
+	void Reset();
+
+public:
+	/** Number of most recent samples the best one is picked from. */
+	int32 WindowSize = 16;
+
+	/** How fast the applied offset can change, in seconds per second. */
+	double MaxSlewRate = 0.05;
+
+	/** Offset errors larger than this are applied at once rather than slewed. */
+	double SnapThreshold = 1.0;
+
+private:
+	struct FSample
+	{
+		/** Server time minus the local time the timestamp has been received at, not compensated for latency. */
+		double RawOffset = 0.0;
+		double RoundTripTime = 0.0;
+	};
+
+	TArray<FSample> Samples;
+	int32 NextSampleIndex = 0;
+
+	double Offset = 0.0;
+	double TargetOffset = 0.0;
+	double LastAdvanceTime = 0.0;
+	double LastServerTime = 0.0;
+	bool bHasOffset = false;
+};
@@ -0,0 +1,50 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "System/TCU_ServerClockEstimator.h"
+
+#include "TCU_ServerClockSubsystem.generated.h"
+
+/**
+ * Smooths the server time seen by clients. AGameStateBase corrects its server time offset whenever the replicated
+ * server time arrives, which makes the time jump back and forth by the network jitter. This subsystem instead feeds
+ * every correction, compensated by the ping of the local player, to a server clock estimator, and exposes the server
+ * time it produces. On the server and in standalone games the time is passed through as is.
+ */
+UCLASS()
+class TONETFALCOMMONUTILITIES_API UTCU_ServerClockSubsystem
+	: public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Returns the subsystem of the world the context object belongs to, or null if the world doesn't have one. */
+	static UTCU_ServerClockSubsystem* Get(const UObject* ContextObject);
+
+	//~FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~End of FTickableGameObject Interface
+
+	/** Returns the smoothed server time. It never goes backwards. */
+	double GetServerTime() const;
+
+	const FTCU_ServerClockEstimator& GetEstimator() const;
+
+protected:
+	//~UWorldSubsystem Interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~End of UWorldSubsystem Interface
+
+private:
+	void SampleServerTime();
+
+private:
+	FTCU_ServerClockEstimator Estimator;
+
+	/** Server time offset of the game state when it was last sampled. A sample is taken whenever it changes. */
+	double LastServerTimeDelta = 0.0;
+	bool bHasServerTimeDelta = false;
+};
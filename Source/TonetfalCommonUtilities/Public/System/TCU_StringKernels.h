@@ -0,0 +1,62 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class ETCU_WhitespaceSet : uint8;
+
+/**
+ * Bulk operations over TCHAR buffers, vectorized with AVX2 or SSE2 on x86 and NEON on ARM, whichever the module has
+ * been compiled for, and scalar code everywhere else. Unicode whitespace is always classified by the scalar code.
+ */
+namespace TCU::StringKernels
+{
+	/** Returns the name of the instruction set the kernels have been compiled for. */
+	TONETFALCOMMONUTILITIES_API const TCHAR* GetInstructionSetName();
+
+	TONETFALCOMMONUTILITIES_API bool IsWhitespace(TCHAR Character, ETCU_WhitespaceSet Whitespace);
+
+	/** Returns the number of whitespace characters the buffer starts with. */
+	TONETFALCOMMONUTILITIES_API int32 CountLeadingWhitespace(const TCHAR* Data, int32 Len,
+		ETCU_WhitespaceSet Whitespace);
+
+	/** Returns the number of whitespace characters the buffer ends with. */
+	TONETFALCOMMONUTILITIES_API int32 CountTrailingWhitespace(const TCHAR* Data, int32 Len,
+		ETCU_WhitespaceSet Whitespace);
+
+	/** Returns the number of whitespace characters in the buffer. */
+	TONETFALCOMMONUTILITIES_API int32 CountWhitespace(const TCHAR* Data, int32 Len, ETCU_WhitespaceSet Whitespace);
+
+	/** Writes whether each character of the buffer is a whitespace. OutIsWhitespace must hold Len elements. */
+	TONETFALCOMMONUTILITIES_API void ClassifyWhitespace(const TCHAR* Data, int32 Len, ETCU_WhitespaceSet Whitespace,
+		bool* OutIsWhitespace);
+
+	/** Converts A-Z to a-z in place. Other characters are left as is. */
+	TONETFALCOMMONUTILITIES_API void ToLowerAscii(TCHAR* Data, int32 Len);
+
+	/** Converts a-z to A-Z in place. Other characters are left as is. */
+	TONETFALCOMMONUTILITIES_API void ToUpperAscii(TCHAR* Data, int32 Len);
+
+	/** Returns the number of characters of the buffer that are contained in the set. */
+	TONETFALCOMMONUTILITIES_API int32 CountCharsInSet(const TCHAR* Data, int32 Len, TConstArrayView<TCHAR> Set);
+
+	/** Writes the pattern Count times in a row. Dest must hold PatternLen * Count elements, and not overlap Pattern. */
+	TONETFALCOMMONUTILITIES_API void FillRepeated(TCHAR* Dest, const TCHAR* Pattern, int32 PatternLen, int32 Count);
+
+	/** Plain versions of the kernels. Used for the tails of the buffers, and as a reference for benchmarks. */
+	namespace Scalar
+	{
+		TONETFALCOMMONUTILITIES_API int32 CountLeadingWhitespace(const TCHAR* Data, int32 Len,
+			ETCU_WhitespaceSet Whitespace);
+		TONETFALCOMMONUTILITIES_API int32 CountTrailingWhitespace(const TCHAR* Data, int32 Len,
+			ETCU_WhitespaceSet Whitespace);
+		TONETFALCOMMONUTILITIES_API int32 CountWhitespace(const TCHAR* Data, int32 Len,
+			ETCU_WhitespaceSet Whitespace);
+		TONETFALCOMMONUTILITIES_API void ClassifyWhitespace(const TCHAR* Data, int32 Len,
+			ETCU_WhitespaceSet Whitespace, bool* OutIsWhitespace);
+		TONETFALCOMMONUTILITIES_API void ToLowerAscii(TCHAR* Data, int32 Len);
+		TONETFALCOMMONUTILITIES_API void ToUpperAscii(TCHAR* Data, int32 Len);
+		TONETFALCOMMONUTILITIES_API int32 CountCharsInSet(const TCHAR* Data, int32 Len, TConstArrayView<TCHAR> Set);
+	}
+}
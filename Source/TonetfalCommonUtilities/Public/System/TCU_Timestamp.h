@@ -0,0 +1,73 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "TCU_Timestamp.generated.h"
+
+UENUM(BlueprintType)
+enum class ETCU_TimeDomain : uint8
+{
+	/** Time of the local world, see UWorld::GetTimeSeconds. */
+	Local,
+
+	/** Time of the server as estimated by the game state, see AGameStateBase::GetServerWorldTimeSeconds. */
+	Server,
+
+	/** Time of the server smoothed on clients, see UTCU_ServerClockSubsystem. */
+	ServerSmoothed,
+};
+
+/**
+ * Point in world time stored as whole microseconds. Unlike float seconds it doesn't lose precision as the world keeps
+ * running, and comparing or subtracting two of them is plain integer arithmetic.
+ */
+USTRUCT(BlueprintType)
+struct TONETFALCOMMONUTILITIES_API FTCU_Timestamp
+{
+	GENERATED_BODY()
+
+public:
+	static constexpr int64 TicksPerSecond = 1000000;
+
+public:
+	FTCU_Timestamp() = default;
+
+	explicit FTCU_Timestamp(int64 InTicks)
+		: Ticks(InTicks)
+	{
+	}
+
+	static FTCU_Timestamp FromSeconds(double Seconds)
+	{
+		return FTCU_Timestamp(FMath::RoundToInt64(Seconds * TicksPerSecond));
+	}
+
+	double ToSeconds() const
+	{
+		return static_cast<double>(Ticks) / TicksPerSecond;
+	}
+
+	/** Returns the number of microseconds between the two timestamps. */
+	int64 operator-(FTCU_Timestamp Other) const { return Ticks - Other.Ticks; }
+
+	FTCU_Timestamp operator+(int64 DeltaTicks) const { return FTCU_Timestamp(Ticks + DeltaTicks); }
+
+	bool operator==(FTCU_Timestamp Other) const { return Ticks == Other.Ticks; }
+	bool operator!=(FTCU_Timestamp Other) const { return Ticks != Other.Ticks; }
+	bool operator<(FTCU_Timestamp Other) const { return Ticks < Other.Ticks; }
+	bool operator<=(FTCU_Timestamp Other) const { return Ticks <= Other.Ticks; }
+	bool operator>(FTCU_Timestamp Other) const { return Ticks > Other.Ticks; }
+	bool operator>=(FTCU_Timestamp Other) const { return Ticks >= Other.Ticks; }
+
+	friend uint32 GetTypeHash(FTCU_Timestamp Timestamp)
+	{
+		return GetTypeHash(Timestamp.Ticks);
+	}
+
+public:
+	/** Microseconds since the world has begun. */
+	UPROPERTY(BlueprintReadOnly, Category="Time")
+	int64 Ticks = 0;
+};
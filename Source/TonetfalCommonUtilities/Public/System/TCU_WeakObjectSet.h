@@ -0,0 +1,254 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#pragma once
+
+#include "UObject/Object.h"
+#include "UObject/UObjectArray.h"
+
+/**
+ * Set of weak references to objects. Like TWeakObjectPtr, elements are the index of the object in GUObjectArray and
+ * its serial number, which changes whenever the index is reused by another object, but they're kept in dense arrays.
+ * A paged table indexed by the object index holds their positions, so adding, removing and finding objects is a
+ * couple of array accesses that never hash or dereference them.
+ *
+ * Elements whose objects are gone aren't removed on their own. They're skipped while iterating, and can be swept in
+ * bulk with Sweep, e.g. once per tick.
+ */
+template<typename ObjectType>
+class TTCU_WeakObjectSet
+{
+public:
+	/** Returns false if the object is already in the set. */
+	bool Add(const ObjectType* Object);
+
+	/** Returns false if the object isn't in the set. */
+	bool Remove(const ObjectType* Object);
+
+	/** Returns false for objects that are gone, which are skipped while iterating as well. */
+	bool Contains(const ObjectType* Object) const;
+
+	/** Removes the elements whose objects are gone. Returns the number of removed elements. */
+	int32 Sweep();
+
+	void Reset();
+
+	/** Number of elements, including the ones whose objects are gone but haven't been swept yet. */
+	int32 Num() const;
+	bool IsEmpty() const;
+
+	/** Calls the callable on each object that is still alive. */
+	template<typename CallableType>
+	void ForEach(CallableType&& Callable) const;
+
+	/** Appends the objects that are still alive to the array. */
+	template<typename AllocatorType>
+	void GetObjects(TArray<ObjectType*, AllocatorType>& OutObjects) const;
+
+private:
+	ObjectType* Resolve(int32 Position) const;
+	void RemoveAtSwap(int32 Position);
+
+	/** Returns the position of the element of the object index, or INDEX_NONE if there's none. */
+	int32 FindPosition(int32 ObjectIndex) const;
+
+	/** Returns the slot the position of the element of the object index is stored in, allocating its page if needed. */
+	int32& GetPositionSlot(int32 ObjectIndex);
+
+private:
+	static constexpr int32 PositionsPageSize = 1024;
+
+	TArray<int32> ObjectIndices;
+	TArray<int32> SerialNumbers;
+
+	/**
+	 * Positions in the dense arrays plus one by the index of the object, zero if the object isn't in the set. Split
+	 * into pages that are only allocated once an object whose index falls into them is added.
+	 */
+	TArray<TArray<int32>> PositionPages;
+};
+
+template<typename ObjectType>
+bool TTCU_WeakObjectSet<ObjectType>::Add(const ObjectType* Object)
+{
+	if (!Object)
+	{
+		return false;
+	}
+
+	const int32 ObjectIndex = GUObjectArray.ObjectToIndex(Object);
+	const int32 SerialNumber = GUObjectArray.AllocateSerialNumber(ObjectIndex);
+
+	const int32 Position = FindPosition(ObjectIndex);
+	if (Position != INDEX_NONE)
+	{
+		if (SerialNumbers[Position] == SerialNumber)
+		{
+			return false;
+		}
+
+		// The element refers to an object that used to have the same index, which is gone
+		SerialNumbers[Position] = SerialNumber;
+		return true;
+	}
+
+	ObjectIndices.Add(ObjectIndex);
+	GetPositionSlot(ObjectIndex) = ObjectIndices.Num();
+	SerialNumbers.Add(SerialNumber);
+
+	return true;
+}
+
+template<typename ObjectType>
+bool TTCU_WeakObjectSet<ObjectType>::Remove(const ObjectType* Object)
+{
+	if (!Object)
+	{
+		return false;
+	}
+
+	// Unlike Contains, objects that are unreachable or garbage are found, so that they can be removed before a sweep
+	const int32 ObjectIndex = GUObjectArray.ObjectToIndex(Object);
+	const int32 Position = FindPosition(ObjectIndex);
+	const FUObjectItem* ObjectItem = GUObjectArray.IndexToObject(ObjectIndex);
+	if (Position == INDEX_NONE || !ObjectItem || ObjectItem->GetSerialNumber() != SerialNumbers[Position])
+	{
+		return false;
+	}
+
+	RemoveAtSwap(Position);
+	return true;
+}
+
+template<typename ObjectType>
+bool TTCU_WeakObjectSet<ObjectType>::Contains(const ObjectType* Object) const
+{
+	if (!Object)
+	{
+		return false;
+	}
+
+	const int32 Position = FindPosition(GUObjectArray.ObjectToIndex(Object));
+	return Position != INDEX_NONE && Resolve(Position) != nullptr;
+}
+
+template<typename ObjectType>
+int32 TTCU_WeakObjectSet<ObjectType>::Sweep()
+{
+	const int32 OldNum = ObjectIndices.Num();
+
+	// Going backwards, elements swapped into a removed position have already been checked
+	for (int32 Position = ObjectIndices.Num() - 1; Position >= 0; Position--)
+	{
+		if (!Resolve(Position))
+		{
+			RemoveAtSwap(Position);
+		}
+	}
+
+	return OldNum - ObjectIndices.Num();
+}
+
+template<typename ObjectType>
+void TTCU_WeakObjectSet<ObjectType>::Reset()
+{
+	ObjectIndices.Reset();
+	SerialNumbers.Reset();
+	PositionPages.Reset();
+}
+
+template<typename ObjectType>
+int32 TTCU_WeakObjectSet<ObjectType>::Num() const
+{
+	return ObjectIndices.Num();
+}
+
+template<typename ObjectType>
+bool TTCU_WeakObjectSet<ObjectType>::IsEmpty() const
+{
+	return ObjectIndices.IsEmpty();
+}
+
+template<typename ObjectType>
+template<typename CallableType>
+void TTCU_WeakObjectSet<ObjectType>::ForEach(CallableType&& Callable) const
+{
+	for (int32 Position = 0; Position < ObjectIndices.Num(); Position++)
+	{
+		if (ObjectType* Object = Resolve(Position))
+		{
+			Invoke(Callable, Object);
+		}
+	}
+}
+
+template<typename ObjectType>
+template<typename AllocatorType>
+void TTCU_WeakObjectSet<ObjectType>::GetObjects(TArray<ObjectType*, AllocatorType>& OutObjects) const
+{
+	OutObjects.Reserve(OutObjects.Num() + ObjectIndices.Num());
+	ForEach([&OutObjects](ObjectType* Object)
+	{
+		OutObjects.Add(Object);
+	});
+}
+
+template<typename ObjectType>
+ObjectType* TTCU_WeakObjectSet<ObjectType>::Resolve(int32 Position) const
+{
+	// Same checks as the ones of TWeakObjectPtr::Get
+	const FUObjectItem* ObjectItem = GUObjectArray.IndexToObject(ObjectIndices[Position]);
+	if (!ObjectItem || ObjectItem->GetSerialNumber() != SerialNumbers[Position] || ObjectItem->IsUnreachable() ||
+		ObjectItem->IsGarbage())
+	{
+		return nullptr;
+	}
+
+	return static_cast<ObjectType*>(static_cast<UObject*>(ObjectItem->Object));
+}
+
+template<typename ObjectType>
+void TTCU_WeakObjectSet<ObjectType>::RemoveAtSwap(int32 Position)
+{
+	GetPositionSlot(ObjectIndices[Position]) = 0;
+
+	const int32 LastPosition = ObjectIndices.Num() - 1;
+	if (Position != LastPosition)
+	{
+		ObjectIndices[Position] = ObjectIndices[LastPosition];
+		SerialNumbers[Position] = SerialNumbers[LastPosition];
+		GetPositionSlot(ObjectIndices[Position]) = Position + 1;
+	}
+
+	ObjectIndices.Pop();
+	SerialNumbers.Pop();
+}
+
+template<typename ObjectType>
+int32 TTCU_WeakObjectSet<ObjectType>::FindPosition(int32 ObjectIndex) const
+{
+	const int32 PageIndex = ObjectIndex / PositionsPageSize;
+	if (!PositionPages.IsValidIndex(PageIndex) || PositionPages[PageIndex].IsEmpty())
+	{
+		return INDEX_NONE;
+	}
+
+	return PositionPages[PageIndex][ObjectIndex % PositionsPageSize] - 1;
+}
+
+template<typename ObjectType>
+int32& TTCU_WeakObjectSet<ObjectType>::GetPositionSlot(int32 ObjectIndex)
+{
+	const int32 PageIndex = ObjectIndex / PositionsPageSize;
+	if (PageIndex >= PositionPages.Num())
+	{
+		PositionPages.SetNum(PageIndex + 1);
+	}
+
+	TArray<int32>& Page = PositionPages[PageIndex];
+	if (Page.IsEmpty())
+	{
+		Page.SetNumZeroed(PositionsPageSize);
+	}
+
+	return Page[ObjectIndex % PositionsPageSize];
+}
@@ -0,0 +1,26 @@
+// Author: Antonio Sidenko (Tonetfal), November 2024
+
+#pragma once
+
+#include "Engine/Engine.h"
+
+/**
+ * Drop-in replacement of UEngine::GetWorldFromContextObject that remembers which world each context object resolved
+ * to. Lookups go through a small direct-mapped cache keyed by the object, so a hit costs a hash and two weak pointer
+ * checks instead of walking the outer chain. Entries of a world are dropped when it's cleaned up.
+ *
+ * The cache is only used on the game thread; other threads always take the slow path. Objects that can move to
+ * another world without being destroyed (e.g. by renaming them into another outer) must be forgotten explicitly.
+ */
+class TONETFALCOMMONUTILITIES_API FTCU_WorldResolver
+{
+public:
+	static UWorld* Resolve(const UObject* ContextObject,
+		EGetWorldErrorMode ErrorMode = EGetWorldErrorMode::LogAndReturnNull);
+
+	/** Drops the cached world of the object. */
+	static void Forget(const UObject* ContextObject);
+
+	/** Drops all the cached worlds. */
+	static void Reset();
+};